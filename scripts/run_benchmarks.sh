@@ -0,0 +1,66 @@
+#!/bin/bash
+
+## ----------------------------------------------------------------------------
+## nexus | run_benchmarks.sh
+##
+## Runs the nexus-bench workload suite (macros/benchmarks) and appends
+## the figures of every workload, as JSON lines, to a results file.
+##
+## Usage: scripts/run_benchmarks.sh [-b nexus-bench] [-o results] [-t threads]
+##        [workload ...]
+## (to be run from the nexus directory; all the workloads by default)
+##
+## The NEXT Collaboration
+## ----------------------------------------------------------------------------
+
+BENCH=bin/nexus-bench
+RESULTS=nexus-bench.jsonl
+THREADS=0
+
+while getopts "b:o:t:" opt; do
+    case $opt in
+        b) BENCH=$OPTARG ;;
+        o) RESULTS=$OPTARG ;;
+        t) THREADS=$OPTARG ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND-1))
+
+# Pinned number of events (and warm-up events, per thread) of every workload
+declare -A NEVENTS=(
+    [NEXT100_Kr83m_optical]=50
+    [NEXT100_bb0nu_drift_EL]=3
+    [NEW_fullKr]=50
+    [NextFlex_fibres]=20
+    [NextTonScale_muons]=200
+    [NEXT100_S2_table_point]=20
+)
+declare -A WARMUP=(
+    [NEXT100_Kr83m_optical]=1
+    [NEXT100_bb0nu_drift_EL]=0
+    [NEW_fullKr]=1
+    [NextFlex_fibres]=1
+    [NextTonScale_muons]=5
+    [NEXT100_S2_table_point]=1
+)
+
+WORKLOADS=${@:-NEXT100_Kr83m_optical NEXT100_bb0nu_drift_EL NEW_fullKr
+                NextFlex_fibres NextTonScale_muons NEXT100_S2_table_point}
+
+status=0
+for workload in $WORKLOADS; do
+    if [ -z "${NEVENTS[$workload]}" ]; then
+        echo "Unknown workload: $workload" >&2
+        status=1
+        continue
+    fi
+
+    echo "Running $workload (${NEVENTS[$workload]} events)"
+    "$BENCH" -n "${NEVENTS[$workload]}" -w "${WARMUP[$workload]}" \
+             -t "$THREADS" -l "$workload" -o "$RESULTS" \
+             "macros/benchmarks/$workload.init.mac" > "bench_$workload.log" 2>&1 \
+        || { echo "$workload failed (see bench_$workload.log)" >&2; status=1; }
+done
+
+exit $status
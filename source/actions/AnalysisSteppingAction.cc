@@ -23,7 +23,8 @@ using namespace nexus;
 
 REGISTER_CLASS(AnalysisSteppingAction, G4UserSteppingAction)
 
-AnalysisSteppingAction::AnalysisSteppingAction(): G4UserSteppingAction()
+AnalysisSteppingAction::AnalysisSteppingAction(): G4UserSteppingAction(),
+                                                  boundary_(0)
 {
 }
 
@@ -68,23 +69,22 @@ void AnalysisSteppingAction::UserSteppingAction(const G4Step* step)
   */
 
   // Retrieve the pointer to the optical boundary process.
-  // We do this only once per run defining our local pointer as static.
-  static G4OpBoundaryProcess* boundary = 0;
-
-  if (!boundary) { // the pointer is not defined yet
+  // We do this only once per run (and thread, since every thread
+  // has its own process instances and stepping action).
+  if (!boundary_) { // the pointer is not defined yet
     // Get the list of processes defined for the optical photon
     // and loop through it to find the optical boundary process.
     G4ProcessVector* pv = pdef->GetProcessManager()->GetProcessList();
     for (size_t i=0; i<pv->size(); i++) {
       if ((*pv)[i]->GetProcessName() == "OpBoundary") {
-	boundary = (G4OpBoundaryProcess*) (*pv)[i];
+	boundary_ = (G4OpBoundaryProcess*) (*pv)[i];
 	break;
       }
     }
   }
 
   if (step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary) {
-    if (boundary->GetStatus() == Detection ){
+    if (boundary_->GetStatus() == Detection ){
       G4String detector_name = step->GetPostStepPoint()->GetTouchableHandle()->GetVolume()->GetName();
       //G4cout << "##### Sensitive Volume: " << detector_name << G4endl;
 
@@ -17,6 +17,7 @@
 #include <map>
 
 class G4Step;
+class G4OpBoundaryProcess;
 
 
 namespace nexus {
@@ -36,6 +37,8 @@ namespace nexus {
   private:
     typedef std::map<G4String, int> detectorCounts;
     detectorCounts my_counts_;
+
+    G4OpBoundaryProcess* boundary_; ///< Optical boundary process of this thread
   };
 
 } // namespace nexus
@@ -0,0 +1,105 @@
+// ----------------------------------------------------------------------------
+// nexus | BenchmarkEventAction.cc
+//
+// This event action measures the wall time taken by every event, for the
+// nexus-bench program, leaving out the first (warm-up) events of every
+// thread. It wraps the event action chosen by the user (if any), which is
+// invoked as usual.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "BenchmarkEventAction.h"
+
+#include <G4AutoLock.hh>
+
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  // Event times of all the threads, and span of the timed events
+  G4Mutex times_mutex = G4MUTEX_INITIALIZER;
+  std::vector<G4double> times;
+  Clock::time_point first_start, last_end;
+}
+
+
+namespace nexus {
+
+
+  G4bool BenchmarkEventAction::enabled_ = false;
+  G4int BenchmarkEventAction::warmup_ = 0;
+
+
+
+  BenchmarkEventAction::BenchmarkEventAction(G4UserEventAction* action):
+    G4UserEventAction(), action_(action), started_(false), nevents_(0)
+  {
+  }
+
+
+
+  BenchmarkEventAction::~BenchmarkEventAction()
+  {
+    delete action_;
+  }
+
+
+
+  void BenchmarkEventAction::SetEventManager(G4EventManager* manager)
+  {
+    G4UserEventAction::SetEventManager(manager);
+    if (action_) action_->SetEventManager(manager);
+  }
+
+
+
+  void BenchmarkEventAction::BeginOfEventAction(const G4Event* event)
+  {
+    // The first event of the thread is timed from here
+    if (!started_) {
+      last_ = Clock::now();
+      started_ = true;
+    }
+
+    if (action_) action_->BeginOfEventAction(event);
+  }
+
+
+
+  void BenchmarkEventAction::EndOfEventAction(const G4Event* event)
+  {
+    if (action_) action_->EndOfEventAction(event);
+
+    Clock::time_point start = last_;
+    last_ = Clock::now();
+
+    // The first events of every thread include the building of its
+    // physics tables, geometry, etc.
+    if (nevents_++ < warmup_) return;
+
+    G4AutoLock lock(&times_mutex);
+    if (times.empty() || start < first_start) first_start = start;
+    if (times.empty() || last_ > last_end) last_end = last_;
+    times.push_back(std::chrono::duration<G4double>(last_ - start).count());
+  }
+
+
+
+  std::vector<G4double> BenchmarkEventAction::GetEventTimes()
+  {
+    G4AutoLock lock(&times_mutex);
+    return times;
+  }
+
+
+
+  G4double BenchmarkEventAction::GetTimedWallTime()
+  {
+    G4AutoLock lock(&times_mutex);
+    if (times.empty()) return 0.;
+    return std::chrono::duration<G4double>(last_end - first_start).count();
+  }
+
+
+} // namespace nexus
@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------------
+// nexus | BenchmarkEventAction.h
+//
+// This event action measures the wall time taken by every event, for the
+// nexus-bench program, leaving out the first (warm-up) events of every
+// thread. It wraps the event action chosen by the user (if any), which is
+// invoked as usual.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef BENCHMARK_EVENT_ACTION_H
+#define BENCHMARK_EVENT_ACTION_H
+
+#include <G4UserEventAction.hh>
+#include <globals.hh>
+
+#include <chrono>
+#include <vector>
+
+
+namespace nexus {
+
+  class BenchmarkEventAction: public G4UserEventAction
+  {
+  public:
+    /// Constructor, given the user event action (may be null)
+    BenchmarkEventAction(G4UserEventAction* action);
+    /// Destructor
+    ~BenchmarkEventAction();
+
+    void SetEventManager(G4EventManager*);
+
+    /// Hook at the beginning of the event loop
+    void BeginOfEventAction(const G4Event*);
+    /// Hook at the end of the event loop
+    void EndOfEventAction(const G4Event*);
+
+    /// Make the action initialization wrap the user event action
+    /// (it must be invoked before the application is created)
+    static void Enable();
+    static G4bool IsEnabled();
+
+    /// Set the number of first events of every thread left out
+    /// of the measurements (warm-up)
+    static void SetWarmup(G4int);
+
+    /// Return the wall time (in seconds) of every event timed so far
+    /// by any thread, in order of completion
+    static std::vector<G4double> GetEventTimes();
+    /// Return the wall time (in seconds) from the start of the first
+    /// timed event to the end of the last one, of any thread
+    static G4double GetTimedWallTime();
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    G4UserEventAction* action_;
+    /// End of the previous event of this thread, so that the time
+    /// of an event includes its primary generation and the storage
+    /// of the previous one
+    Clock::time_point last_;
+    G4bool started_;
+    G4int nevents_; ///< Events processed by this thread
+
+    static G4bool enabled_;
+    static G4int warmup_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void BenchmarkEventAction::Enable() { enabled_ = true; }
+  inline G4bool BenchmarkEventAction::IsEnabled() { return enabled_; }
+  inline void BenchmarkEventAction::SetWarmup(G4int n) { warmup_ = n; }
+
+} // namespace nexus
+
+#endif
@@ -27,6 +27,8 @@ namespace nexus {
 
 REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
 
+  G4ThreadLocal DefaultEventAction* DefaultEventAction::instance_ = 0;
+
   DefaultEventAction::DefaultEventAction():
     G4UserEventAction(), nevt_(0), nupdate_(10), energy_threshold_(0.), energy_max_(DBL_MAX)
   {
@@ -45,12 +47,15 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
     max_energy_cmd.SetParameterName("max_energy", true);
     max_energy_cmd.SetUnitCategory("Energy");
     max_energy_cmd.SetRange("max_energy>0.");
+
+    instance_ = this;
   }
 
 
 
   DefaultEventAction::~DefaultEventAction()
   {
+    if (instance_ == this) instance_ = 0;
   }
 
 
@@ -99,7 +104,7 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
       } else {
 	pm->InteractingEvent(false);
       }
-      if (!event->IsAborted() && edep > energy_threshold_ && edep < energy_max_) {
+      if (!event->IsAborted() && InEnergyWindow(edep)) {
 	pm->StoreCurrentEvent(true);
       } else {
 	pm->StoreCurrentEvent(false);
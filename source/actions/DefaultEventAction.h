@@ -33,13 +33,31 @@ namespace nexus {
     /// Hook at the end of the event loop
     void EndOfEventAction(const G4Event*);
 
+    /// Returns whether an event depositing the given energy is saved
+    G4bool InEnergyWindow(G4double edep) const;
+
+    /// Returns the event action of this thread, if it is of this class
+    /// (e.g., for the stacking action to apply the same energy window)
+    static const DefaultEventAction* Instance();
+
   private:
     G4GenericMessenger* msg_;
     G4int nevt_, nupdate_;
     G4double energy_threshold_;
     G4double energy_max_;
+
+    static G4ThreadLocal DefaultEventAction* instance_;
   };
 
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4bool DefaultEventAction::InEnergyWindow(G4double edep) const
+  { return edep > energy_threshold_ && edep < energy_max_; }
+
+  inline const DefaultEventAction* DefaultEventAction::Instance()
+  { return instance_; }
+
 } // namespace nexus
 
 #endif
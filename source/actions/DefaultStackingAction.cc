@@ -1,36 +1,78 @@
 // ----------------------------------------------------------------------------
 // nexus | DefaultStackingAction.cc
 //
-// This class is an example of how to implement a stacking action, if needed.
-// At the moment, it is not used in the NEXT simulations.
+// This is the default stacking action of the NEXT simulations. By default,
+// all tracks are processed in a single stage. Optionally, optical photons
+// (and ionization electrons) are postponed to a second stage, which is only
+// processed if the energy deposited in the first one is within the window
+// of energies of the events to be saved by the DefaultEventAction.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 
 #include "DefaultStackingAction.h"
+#include "DefaultEventAction.h"
+#include "Trajectory.h"
+#include "IonizationElectron.h"
 #include "FactoryBase.h"
+#include "PhotonStream.h"
+
+#include <G4Track.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4Event.hh>
+#include <G4EventManager.hh>
+#include <G4StackManager.hh>
+#include <G4TrajectoryContainer.hh>
+#include <G4GenericMessenger.hh>
 
 
 using namespace nexus;
 
 REGISTER_CLASS(DefaultStackingAction, G4UserStackingAction)
 
-DefaultStackingAction::DefaultStackingAction(): G4UserStackingAction()
+DefaultStackingAction::DefaultStackingAction():
+  G4UserStackingAction(), msg_(0),
+  postpone_optical_(false), postpone_ie_(false), stage_(0)
 {
+  msg_ = new G4GenericMessenger(this, "/Actions/DefaultStackingAction/",
+    "Control commands of the default stacking action.");
+
+  // The energy window is that of the DefaultEventAction
+  msg_->DeclareProperty("postpone_optical", postpone_optical_,
+    "Track the optical photons only for events within the energy window.");
+
+  msg_->DeclareProperty("postpone_ie", postpone_ie_,
+    "Track the ionization electrons only for events within the energy window.");
 }
 
 
 
 DefaultStackingAction::~DefaultStackingAction()
 {
+  delete msg_;
 }
 
 
 
 G4ClassificationOfNewTrack
-DefaultStackingAction::ClassifyNewTrack(const G4Track* /*track*/)
+DefaultStackingAction::ClassifyNewTrack(const G4Track* track)
 {
+  const G4ParticleDefinition* pdef = track->GetDefinition();
+
+  // Only the first stage of the event is split
+  if (stage_ == 0) {
+    if (postpone_optical_ && pdef == G4OpticalPhoton::Definition())
+      return fWaiting;
+    if (postpone_ie_ && pdef == IonizationElectron::Definition())
+      return fWaiting;
+  }
+
+  // While photons are being streamed, a track of every chunk is kept
+  // waiting, so that a new stage (and chunk) starts once it is done
+  if (PhotonStream::Instance().TakeMarker())
+    return fWaiting;
+
   return fUrgent;
 }
 
@@ -38,12 +80,67 @@ DefaultStackingAction::ClassifyNewTrack(const G4Track* /*track*/)
 
 void DefaultStackingAction::NewStage()
 {
-  return;
+  // Nothing to decide once the postponed particles are being tracked
+  // (or if none were postponed)
+  if (stage_++ > 0 || !(postpone_optical_ || postpone_ie_)) {
+    PhotonStream::Instance().StackNextChunk();
+    return;
+  }
+
+  // Without the DefaultEventAction there is no window to apply
+  const DefaultEventAction* event_action = DefaultEventAction::Instance();
+  if (!event_action) {
+    static G4ThreadLocal G4bool warned = false;
+    if (!warned) {
+      G4Exception("[DefaultStackingAction]", "NewStage()", JustWarning,
+        "The postponed particles are always tracked: there is no energy "
+        "window without the DefaultEventAction.");
+      warned = true;
+    }
+    PhotonStream::Instance().StackNextChunk();
+    return;
+  }
+
+  // Energy deposited in the ionization sensitive detectors during the
+  // first stage (the optical photons and the ionization electrons do
+  // not contribute), computed as in DefaultEventAction
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  G4TrajectoryContainer* tc = event->GetTrajectoryContainer();
+
+  // Without trajectories, no energy can be counted and the event
+  // will be rejected. (This is worth a warning, as it may well be
+  // that the trajectories are not being stored.)
+  if (!tc) {
+    static G4ThreadLocal G4bool warned_tc = false;
+    if (!warned_tc) {
+      G4Exception("[DefaultStackingAction]", "NewStage()", JustWarning,
+        "No trajectories in the first stage of the event: its postponed "
+        "particles are discarded. Are the trajectories being stored?");
+      warned_tc = true;
+    }
+  }
+
+  G4double edep = 0.;
+  if (tc) {
+    for (unsigned int i=0; i<tc->size(); ++i) {
+      Trajectory* trj = dynamic_cast<Trajectory*>((*tc)[i]);
+      if (trj) edep += trj->GetEnergyDeposit();
+    }
+  }
+
+  // The event will be rejected: forget the postponed particles
+  if (!event_action->InEnergyWindow(edep)) {
+    stackManager->clear();
+    PhotonStream::Instance().Clear();
+    return;
+  }
+
+  PhotonStream::Instance().StackNextChunk();
 }
 
 
 
 void DefaultStackingAction::PrepareNewEvent()
 {
-  return;
+  stage_ = 0;
 }
@@ -1,8 +1,11 @@
 // ----------------------------------------------------------------------------
 // nexus | DefaultStackingAction.h
 //
-// This class is an example of how to implement a stacking action, if needed.
-// At the moment, it is not used in the NEXT simulations.
+// This is the default stacking action of the NEXT simulations. By default,
+// all tracks are processed in a single stage. Optionally, optical photons
+// (and ionization electrons) are postponed to a second stage, which is only
+// processed if the energy deposited in the first one is within the window
+// of energies of the events to be saved by the DefaultEventAction.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -12,6 +15,8 @@
 
 #include <G4UserStackingAction.hh>
 
+class G4GenericMessenger;
+
 
 namespace nexus {
 
@@ -25,9 +30,22 @@ namespace nexus {
     /// Destructor
     ~DefaultStackingAction();
 
+    /// Sends the optical photons (and, optionally, the ionization
+    /// electrons) to the waiting stack if two-stage processing is on
     virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+    /// Invoked once the first stage is over. The remaining tracks are
+    /// discarded if the event deposited an energy outside the window.
+    /// It also adds to the event the next chunk of streamed photons.
     virtual void NewStage();
     virtual void PrepareNewEvent();
+
+  private:
+    G4GenericMessenger* msg_;
+
+    G4bool postpone_optical_;  ///< Postpone the optical photons
+    G4bool postpone_ie_;       ///< Postpone the ionization electrons
+
+    G4int stage_; ///< Number of the current stage of the event
   };
 
 } // end namespace nexus
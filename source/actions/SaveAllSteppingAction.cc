@@ -15,6 +15,8 @@
 #include <G4VPersistencyManager.hh>
 #include <G4ProcessManager.hh>
 #include <G4ParticleTable.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VProcess.hh>
 
 using namespace nexus;
 
@@ -52,33 +54,40 @@ SaveAllSteppingAction::~SaveAllSteppingAction()
 
 void SaveAllSteppingAction::UserSteppingAction(const G4Step* step)
 {
-  G4ParticleDefinition* pdef          = step->GetTrack()->GetDefinition();
-  G4int                 track_id      = step->GetTrack()->GetTrackID();
-  G4String              particle_name = pdef->GetParticleName();
+  G4ParticleDefinition* pdef     = step->GetTrack()->GetDefinition();
+  G4int                 track_id = step->GetTrack()->GetTrackID();
 
   if (!KeepParticle(pdef)) return;
 
   G4StepPoint* pre  = step->GetPreStepPoint();
   G4StepPoint* post = step->GetPostStepPoint();
 
-  G4ThreeVector initial_pos = pre ->GetPosition();
-  G4ThreeVector   final_pos = post->GetPosition();
+  const G4VPhysicalVolume* initial_volume = pre ->GetTouchableHandle()->GetVolume();
+  const G4VPhysicalVolume*   final_volume = post->GetTouchableHandle()->GetVolume();
+  const G4VProcess*             process   = post->GetProcessDefinedStep();
 
-  G4String initial_volume = pre ->GetTouchableHandle()->GetVolume()->GetName();
-  G4String   final_volume = post->GetTouchableHandle()->GetVolume()->GetName();
-  G4String      proc_name = post->GetProcessDefinedStep()->GetProcessName();
-
-  if (!KeepVolume(initial_volume, final_volume))
+  if (!KeepVolume(initial_volume) && !KeepVolume(final_volume))
     return;
 
-  std::pair<G4int, G4String> key = std::make_pair(track_id, particle_name);
+  if ((size_t) track_id >= step_count_.size())
+    step_count_.resize(track_id + 1, 0);
+
+  steps_.track_id      .push_back(track_id);
+  steps_.step_id       .push_back(step_count_[track_id]++);
+  steps_.particle      .push_back(Intern(pdef, pdef->GetParticleName()));
+  steps_.initial_volume.push_back(Intern(initial_volume, initial_volume->GetName()));
+  steps_.  final_volume.push_back(Intern(  final_volume,   final_volume->GetName()));
+  steps_.process       .push_back(Intern(process, process->GetProcessName()));
+  steps_.initial_pos   .push_back(pre ->GetPosition());
+  steps_.  final_pos   .push_back(post->GetPosition());
+}
 
-  initial_volumes_[key].push_back(initial_volume);
-    final_volumes_[key].push_back(  final_volume);
-       proc_names_[key].push_back(     proc_name);
 
-  initial_poss_   [key].push_back(initial_pos);
-    final_poss_   [key].push_back(  final_pos);
+G4int SaveAllSteppingAction::Intern(const void* object, const G4String& name)
+{
+  auto result = name_index_.emplace(object, names_.size());
+  if (result.second) names_.push_back(name);
+  return result.first->second;
 }
 
 
@@ -96,6 +105,7 @@ void SaveAllSteppingAction::AddSelectedParticle(G4String particle_name)
 void SaveAllSteppingAction::AddSelectedVolume(G4String volume_name)
 {
   selected_volumes_.push_back(volume_name);
+  kept_volumes_.clear();
 }
 
 
@@ -108,27 +118,43 @@ G4bool SaveAllSteppingAction::KeepParticle(G4ParticleDefinition* pdef)
 }
 
 
-G4bool SaveAllSteppingAction::KeepVolume(G4String& initial_volume, G4String& final_volume)
+G4bool SaveAllSteppingAction::KeepVolume(const G4VPhysicalVolume* volume)
 {
   if (!selected_volumes_.size()) return true;
 
-  for (auto volume=selected_volumes_.begin(); volume != selected_volumes_.end(); volume++)
+  // The names are only compared the first time a volume is seen
+  auto it = kept_volumes_.find(volume);
+  if (it != kept_volumes_.end()) return it->second;
+
+  G4bool keep = false;
+  for (auto selected=selected_volumes_.begin(); selected != selected_volumes_.end(); selected++)
   {
-    if (G4StrUtil::contains(initial_volume, *volume)) return true;
-    if (G4StrUtil::contains(  final_volume, *volume)) return true;
+    if (G4StrUtil::contains(volume->GetName(), *selected)) keep = true;
   }
 
-  return false;
+  kept_volumes_[volume] = keep;
+  return keep;
 }
 
 
 
 void SaveAllSteppingAction::Reset()
 {
-  initial_volumes_.clear();
-    final_volumes_.clear();
-       proc_names_.clear();
+  // The memory of the buffer is kept for the next event
+  steps_.clear();
+  step_count_.clear();
+}
+
 
-  initial_poss_   .clear();
-    final_poss_   .clear();
+
+void SaveAllSteppingAction::StepBuffer::clear()
+{
+  track_id      .clear();
+  step_id       .clear();
+  particle      .clear();
+  initial_volume.clear();
+    final_volume.clear();
+  process       .clear();
+  initial_pos   .clear();
+    final_pos   .clear();
 }
@@ -18,12 +18,10 @@
 #include <globals.hh>
 
 #include <vector>
-#include <map>
+#include <unordered_map>
 
 class G4Step;
-
-template<typename T>
-using StepContainer = std::map<std::pair<G4int, G4String>, std::vector<T>>;
+class G4VPhysicalVolume;
 
 
 namespace nexus {
@@ -32,6 +30,24 @@ namespace nexus {
 
   class SaveAllSteppingAction: public G4UserSteppingAction
   {
+  public:
+    /// Steps of the current event, in structure-of-arrays layout
+    /// and in the order they were taken. Particles, volumes and
+    /// processes are given as indices of their names (see GetName).
+    struct StepBuffer {
+      std::vector<G4int> track_id;
+      std::vector<G4int> step_id;  ///< Number of the step within its track
+      std::vector<G4int> particle;
+      std::vector<G4int> initial_volume;
+      std::vector<G4int> final_volume;
+      std::vector<G4int> process;
+      std::vector<G4ThreeVector> initial_pos;
+      std::vector<G4ThreeVector> final_pos;
+
+      size_t size() const;
+      void clear();
+    };
+
   public:
     /// Constructor
     SaveAllSteppingAction();
@@ -40,43 +56,49 @@ namespace nexus {
 
     virtual void UserSteppingAction(const G4Step*);
 
+    /// Return the steps recorded in the current event
+    const StepBuffer& GetSteps() const;
+    /// Return the name of a particle, volume or process given its index
+    const G4String& GetName(G4int) const;
+
+    void Reset();
+
+  private:
+    void   AddSelectedParticle(G4String);
+    void   AddSelectedVolume  (G4String);
+    G4bool        KeepVolume  (const G4VPhysicalVolume*);
+    G4bool        KeepParticle(G4ParticleDefinition*);
+
+    /// Return the index of the name of an object (particle
+    /// definition, volume or process), adding it if new
+    G4int Intern(const void* object, const G4String& name);
+
   private:
     G4GenericMessenger* msg_;
 
     std::vector<G4String>              selected_volumes_;
     std::vector<G4ParticleDefinition*> selected_particles_;
 
-    StepContainer<G4String> initial_volumes_;
-    StepContainer<G4String>   final_volumes_;
-    StepContainer<G4String>      proc_names_;
-
-    StepContainer<G4ThreeVector> initial_poss_;
-    StepContainer<G4ThreeVector>   final_poss_;
-
-  public:
+    StepBuffer steps_;
+    std::vector<G4int> step_count_; ///< Steps of every track (by id)
 
-    StepContainer<G4String> get_initial_volumes();
-    StepContainer<G4String> get_final_volumes();
-    StepContainer<G4String> get_proc_names();
+    std::vector<G4String> names_;
+    std::unordered_map<const void*, G4int> name_index_;
 
-    StepContainer<G4ThreeVector> get_initial_poss();
-    StepContainer<G4ThreeVector> get_final_poss();
+    /// Whether every volume seen so far passes the volume selection
+    std::unordered_map<const G4VPhysicalVolume*, G4bool> kept_volumes_;
+  };
 
-    void Reset();
+  // INLINE DEFINITIONS //////////////////////////////////////////////
 
-  private:
-    void   AddSelectedParticle(G4String);
-    void   AddSelectedVolume  (G4String);
-    G4bool        KeepVolume  (G4String&, G4String&);
-    G4bool        KeepParticle(G4ParticleDefinition*);
-  };
+  inline size_t SaveAllSteppingAction::StepBuffer::size() const
+  { return track_id.size(); }
 
-inline StepContainer<G4String> SaveAllSteppingAction::get_initial_volumes(){return initial_volumes_;}
-inline StepContainer<G4String> SaveAllSteppingAction::get_final_volumes  (){return   final_volumes_;}
-inline StepContainer<G4String> SaveAllSteppingAction::get_proc_names     (){return      proc_names_;}
+  inline const SaveAllSteppingAction::StepBuffer&
+  SaveAllSteppingAction::GetSteps() const { return steps_; }
 
-inline StepContainer<G4ThreeVector> SaveAllSteppingAction::get_initial_poss(){return initial_poss_;}
-inline StepContainer<G4ThreeVector> SaveAllSteppingAction::get_final_poss  (){return   final_poss_;}
+  inline const G4String& SaveAllSteppingAction::GetName(G4int i) const
+  { return names_[i]; }
 
 } // namespace nexus
 
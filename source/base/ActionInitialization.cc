@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// nexus | ActionInitialization.cc
+//
+// This class instantiates, through the object factory, the primary generator
+// and the user actions chosen in the configuration macro. In multithreaded
+// mode it is invoked once per worker thread, so that every thread gets its
+// own instances.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ActionInitialization.h"
+
+#include "PrimaryGeneration.h"
+#include "PersistencyManagerBase.h"
+#include "FactoryBase.h"
+#include "BenchmarkEventAction.h"
+
+#include <G4Threading.hh>
+#include <G4VPrimaryGenerator.hh>
+#include <G4UserRunAction.hh>
+#include <G4UserEventAction.hh>
+#include <G4UserTrackingAction.hh>
+#include <G4UserSteppingAction.hh>
+#include <G4UserStackingAction.hh>
+
+using namespace nexus;
+
+
+
+ActionInitialization::ActionInitialization(G4String gen_name, G4String pm_name,
+                                           G4String runact_name, G4String evtact_name,
+                                           G4String stkact_name, G4String trkact_name,
+                                           G4String stepact_name):
+  G4VUserActionInitialization(),
+  gen_name_(gen_name), pm_name_(pm_name),
+  runact_name_(runact_name), evtact_name_(evtact_name),
+  stkact_name_(stkact_name), trkact_name_(trkact_name),
+  stepact_name_(stepact_name),
+  master_gen_(0), master_evtact_(0), master_stkact_(0),
+  master_trkact_(0), master_stepact_(0)
+{
+}
+
+
+
+ActionInitialization::~ActionInitialization()
+{
+  delete master_gen_;
+  delete master_evtact_;
+  delete master_stkact_;
+  delete master_trkact_;
+  delete master_stepact_;
+}
+
+
+
+void ActionInitialization::BuildForMaster() const
+{
+  // Only the run action is meaningful in the master thread
+  if (runact_name_ != "")
+    SetUserAction(ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_));
+
+  // The configuration macros are executed by the master thread, and only
+  // the commands it knows are passed on to the worker threads. Hence, we
+  // create here (and never use) instances of the generator and the other
+  // actions, so that their messengers exist in the master thread as well.
+  // They are kept until the action initialization is deleted.
+  if (master_gen_) return;
+
+  master_gen_ = ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_);
+
+  if (evtact_name_ != "")
+    master_evtact_ = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
+
+  if (stkact_name_ != "")
+    master_stkact_ = ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_);
+
+  if (trkact_name_ != "")
+    master_trkact_ = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
+
+  if (stepact_name_ != "")
+    master_stepact_ = ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_);
+}
+
+
+
+void ActionInitialization::Build() const
+{
+  // Every worker thread gets its own persistency manager, which writes
+  // through the one owned by the master thread. (The instance of the
+  // master thread is created by NexusApp, before the configuration
+  // macros are executed.)
+  if (!G4Threading::IsMasterThread())
+    ObjFactory<PersistencyManagerBase>::Instance().CreateObject(pm_name_);
+
+  // Set the primary generation instance
+  PrimaryGeneration* pg = new PrimaryGeneration();
+  pg->SetGenerator(ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_));
+  SetUserAction(pg);
+
+  // Set the user action instances, if any
+  if (runact_name_ != "")
+    SetUserAction(ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_));
+
+  G4UserEventAction* evtact = 0;
+  if (evtact_name_ != "")
+    evtact = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
+
+  // The benchmark program times the events through the event action
+  if (BenchmarkEventAction::IsEnabled())
+    evtact = new BenchmarkEventAction(evtact);
+
+  if (evtact)
+    SetUserAction(evtact);
+
+  if (stkact_name_ != "")
+    SetUserAction(ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_));
+
+  if (trkact_name_ != "")
+    SetUserAction(ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_));
+
+  if (stepact_name_ != "")
+    SetUserAction(ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_));
+}
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// nexus | ActionInitialization.h
+//
+// This class instantiates, through the object factory, the primary generator
+// and the user actions chosen in the configuration macro. In multithreaded
+// mode it is invoked once per worker thread, so that every thread gets its
+// own instances.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ACTION_INITIALIZATION_H
+#define ACTION_INITIALIZATION_H
+
+#include <G4VUserActionInitialization.hh>
+#include <globals.hh>
+
+class G4VPrimaryGenerator;
+class G4UserEventAction;
+class G4UserStackingAction;
+class G4UserTrackingAction;
+class G4UserSteppingAction;
+
+namespace nexus {
+
+  class ActionInitialization: public G4VUserActionInitialization
+  {
+  public:
+    /// Constructor providing the names of the generator, persistency
+    /// manager and user actions (empty names are ignored)
+    ActionInitialization(G4String gen_name, G4String pm_name,
+                         G4String runact_name, G4String evtact_name,
+                         G4String stkact_name, G4String trkact_name,
+                         G4String stepact_name);
+    /// Destructor
+    ~ActionInitialization();
+
+    /// Creates the user actions of the master thread (run action only)
+    virtual void BuildForMaster() const;
+
+    /// Creates the generator and the user actions of a (worker) thread
+    virtual void Build() const;
+
+  private:
+    G4String gen_name_;     ///< Name of the chosen primary generator
+    G4String pm_name_;      ///< Name of the chosen persistency manager
+    G4String runact_name_;  ///< Name of the chosen run action
+    G4String evtact_name_;  ///< Name of the chosen event action
+    G4String stkact_name_;  ///< Name of the chosen stacking action
+    G4String trkact_name_;  ///< Name of the chosen tracking action
+    G4String stepact_name_; ///< Name of the chosen stepping action
+
+    // Instances created in the master thread only for their messengers
+    mutable G4VPrimaryGenerator* master_gen_;
+    mutable G4UserEventAction* master_evtact_;
+    mutable G4UserStackingAction* master_stkact_;
+    mutable G4UserTrackingAction* master_trkact_;
+    mutable G4UserSteppingAction* master_stepact_;
+  };
+
+} // namespace nexus
+
+#endif
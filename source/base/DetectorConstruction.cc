@@ -9,6 +9,8 @@
 #include "DetectorConstruction.h"
 
 #include "GeometryBase.h"
+#include "SensorRegistry.h"
+#include "NexusMaterialCache.h"
 
 #include <G4Box.hh>
 #include <G4Material.hh>
@@ -16,6 +18,12 @@
 #include <G4LogicalVolume.hh>
 #include <G4VisAttributes.hh>
 #include <G4PVPlacement.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4VSensitiveDetector.hh>
+#include <G4SDManager.hh>
+#include <G4Threading.hh>
+
+#include <map>
 
 
 using namespace nexus;
@@ -48,6 +56,15 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // default values.
   geometry_->Construct();
 
+  // Keep track of the sensitive detectors set by the geometry,
+  // so that they can be cloned for the worker threads
+  sensitive_volumes_.clear();
+  G4LogicalVolumeStore* lvstore = G4LogicalVolumeStore::GetInstance();
+  for (G4LogicalVolume* lv: *lvstore) {
+    if (lv->GetSensitiveDetector())
+      sensitive_volumes_.push_back(std::make_pair(lv, lv->GetSensitiveDetector()));
+  }
+
   // We define now the world volume as an empty box big enough
   // to fit the user's geometry inside.
 
@@ -73,5 +90,38 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   new G4PVPlacement(0, G4ThreeVector(0,0,0),
 		    geometry_logic, geometry_logic->GetName(), world_logic, false, 0);
 
+  // Locate the sensors registered by the geometry
+  SensorRegistry::Instance().Build(world_physi);
+
+  // All the materials are defined by now: resolve the properties
+  // the physics processes look up during tracking
+  NexusMaterialCache::Build();
+
   return world_physi;
 }
+
+
+
+void DetectorConstruction::ConstructSDandField()
+{
+  // Fields are thread-local, so they are created in every thread
+  geometry_->ConstructField();
+
+  // Nothing to do in the master thread (or in sequential mode):
+  // the sensitive detectors were already set in Construct()
+  if (G4Threading::IsMasterThread()) return;
+
+  // A sensitive detector may be shared by several logical volumes,
+  // in which case they must share the clone as well
+  std::map<G4VSensitiveDetector*, G4VSensitiveDetector*> clones;
+
+  for (unsigned int i=0; i<sensitive_volumes_.size(); ++i) {
+    G4VSensitiveDetector* sd = sensitive_volumes_[i].second;
+    G4VSensitiveDetector*& clone = clones[sd];
+    if (!clone) {
+      clone = sd->Clone();
+      G4SDManager::GetSDMpointer()->AddNewDetector(clone);
+    }
+    SetSensitiveDetector(sensitive_volumes_[i].first, clone);
+  }
+}
@@ -10,8 +10,12 @@
 #define DETECTOR_CONSTRUCTION_H
 
 #include <G4VUserDetectorConstruction.hh>
+#include <vector>
+#include <utility>
 
 class G4GenericMessenger;
+class G4LogicalVolume;
+class G4VSensitiveDetector;
 
 
 namespace nexus {
@@ -30,6 +34,12 @@ namespace nexus {
     /// It returns the physical volume that represents the world.
     virtual G4VPhysicalVolume* Construct();
 
+    /// Invoked by the run manager in every thread. The geometries create
+    /// their sensitive detectors in Construct(), which only runs in the
+    /// master thread, so the worker threads get here clones of them.
+    /// The fields of the geometry are created here, in every thread.
+    virtual void ConstructSDandField();
+
     /// Set a detector geometry
     void SetGeometry(GeometryBase*);
     /// Get the detector geometry
@@ -37,6 +47,9 @@ namespace nexus {
 
   private:
     GeometryBase* geometry_;
+
+    /// Sensitive detectors set by the geometry, and their volumes
+    std::vector<std::pair<G4LogicalVolume*, G4VSensitiveDetector*> > sensitive_volumes_;
   };
 
 
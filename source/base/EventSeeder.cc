@@ -0,0 +1,61 @@
+// ----------------------------------------------------------------------------
+// nexus | EventSeeder.cc
+//
+// This class derives the state of the random engine of every event from
+// the run seed and the global event ID (start_id plus the Geant4 event ID)
+// with a counter-based generator. Events are thus reproduced bit by bit
+// however the production is split into jobs or threads, and any of them
+// can be rerun on its own.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "EventSeeder.h"
+
+#include "Philox.h"
+
+#include <Randomize.hh>
+
+
+namespace nexus {
+
+
+  EventSeeder& EventSeeder::Instance()
+  {
+    static EventSeeder instance;
+    return instance;
+  }
+
+
+
+  EventSeeder::EventSeeder(): run_seed_(0), enabled_(false)
+  {
+  }
+
+
+
+  void EventSeeder::SeedEvent(G4long event_id) const
+  {
+    // Null-terminated, as some engines expect
+    long seeds[5] = {0, 0, 0, 0, 0};
+    GetEventSeeds(run_seed_, event_id, seeds);
+    G4Random::setTheSeeds(seeds, 4);
+  }
+
+
+
+  void EventSeeder::GetEventSeeds(G4long run_seed, G4long event_id, long seeds[4])
+  {
+    // The event ID is the counter and the run seed, the key
+    PhiloxCounter counter = {std::uint32_t(event_id), std::uint32_t(event_id >> 32), 0, 0};
+    PhiloxKey key = {std::uint32_t(run_seed), std::uint32_t(run_seed >> 32)};
+
+    PhiloxCounter words = Philox4x32(counter, key);
+
+    // Zero words would end the list of seeds of some engines
+    for (int i=0; i<4; i++)
+      seeds[i] = words[i] ? long(words[i]) : 1;
+  }
+
+
+} // end namespace nexus
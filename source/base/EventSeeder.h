@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// nexus | EventSeeder.h
+//
+// This class derives the state of the random engine of every event from
+// the run seed and the global event ID (start_id plus the Geant4 event ID)
+// with a counter-based generator. Events are thus reproduced bit by bit
+// however the production is split into jobs or threads, and any of them
+// can be rerun on its own.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef EVENT_SEEDER_H
+#define EVENT_SEEDER_H
+
+#include <globals.hh>
+
+
+namespace nexus {
+
+  class EventSeeder
+  {
+  public:
+    /// Return the seeder of the application (configured by the
+    /// master thread before the run, read by all the threads)
+    static EventSeeder& Instance();
+
+    /// Set the seed of the run
+    void SetRunSeed(G4long);
+    /// Return the seed of the run
+    G4long GetRunSeed() const;
+
+    /// Enable or disable the seeding of every event
+    void SetEnabled(G4bool);
+    /// Return true if every event is seeded on its own
+    G4bool IsEnabled() const;
+
+    /// Seed the random engine of the current thread for the given event
+    void SeedEvent(G4long event_id) const;
+
+    /// Return the seeds of the random engine for a run seed and event
+    static void GetEventSeeds(G4long run_seed, G4long event_id, long seeds[4]);
+
+  private:
+    EventSeeder();
+
+  private:
+    G4long run_seed_;
+    G4bool enabled_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void EventSeeder::SetRunSeed(G4long seed) { run_seed_ = seed; }
+  inline G4long EventSeeder::GetRunSeed() const { return run_seed_; }
+
+  inline void EventSeeder::SetEnabled(G4bool enabled) { enabled_ = enabled; }
+  inline G4bool EventSeeder::IsEnabled() const { return enabled_; }
+
+} // end namespace nexus
+
+#endif
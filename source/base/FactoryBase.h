@@ -41,9 +41,17 @@ public:
     }
   }
 
-  //
+  // The registry is only read here, so that worker threads
+  // can create their own objects concurrently.
   T* CreateObject(const std::string& tag) {
-    return registry_[tag]->CreateObject();
+    typename std::map<std::string, ObjCreatorBase<T>*>::const_iterator it =
+      registry_.find(tag);
+    if (it == registry_.end()) {
+      std::string msg = "Unknown key '" + tag + "' creating an object in the factory.";
+      G4Exception("ObjFactory::CreateObject()", "", FatalException, msg.c_str());
+      return 0;
+    }
+    return it->second->CreateObject();
   }
 
 private:
@@ -1,9 +1,10 @@
 // ----------------------------------------------------------------------------
 // nexus | NexusApp.cc
 //
-// This class is the run manager of the nexus simulation. It takes care of
-// setting up the simulation (geometry, physics lists, generators, actions),
-// so that it is ready to be run.
+// This class is the application of the nexus simulation. It creates the
+// (sequential or multithreaded) run manager and takes care of setting up
+// the simulation (geometry, physics lists, generators, actions), so that
+// it is ready to be run.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -11,31 +12,39 @@
 #include "NexusApp.h"
 
 #include "DetectorConstruction.h"
-#include "PrimaryGeneration.h"
+#include "ActionInitialization.h"
 #include "PersistencyManagerBase.h"
 #include "BatchSession.h"
 #include "FactoryBase.h"
+#include "EventSeeder.h"
 
 #include <G4GenericPhysicsList.hh>
+#include <G4RunManagerFactory.hh>
 #include <G4UImanager.hh>
 #include <G4StateManager.hh>
 #include <G4VPersistencyManager.hh>
-#include <G4UserRunAction.hh>
-#include <G4UserEventAction.hh>
-#include <G4UserTrackingAction.hh>
-#include <G4UserSteppingAction.hh>
-#include <G4UserStackingAction.hh>
 
 using namespace nexus;
 
 
 
-NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
-                                         geo_name_(""), pm_name_(""),
-                                         runact_name_(""), evtact_name_(""),
-                                         stepact_name_(""), trkact_name_(""),
-                                         stkact_name_("")
+NexusApp::NexusApp(G4String init_macro, G4int nthreads): run_manager_(0),
+                                                         gen_name_(""),
+                                                         geo_name_(""), pm_name_(""),
+                                                         runact_name_(""), evtact_name_(""),
+                                                         stepact_name_(""), trkact_name_(""),
+                                                         stkact_name_("")
 {
+  // Create the run manager. Worker threads share the (read-only)
+  // geometry and physics tables built by the master thread.
+  if (nthreads > 0) {
+    run_manager_ =
+      G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default, nthreads);
+  }
+  else {
+    run_manager_ = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Serial);
+  }
+
   // Create and configure a generic messenger for the app
   msg_ = new G4GenericMessenger(this, "/nexus/", "Nexus control commands.");
 
@@ -53,6 +62,12 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   msg_->DeclareMethod("random_seed", &NexusApp::SetRandomSeed,
                       "Set a seed for the random number generator.");
 
+  // Define a command to derive the random state of every event from
+  // the seed and its global event ID, so that it can be reproduced alone
+  msg_->DeclareMethod("event_seeding", &NexusApp::SetEventSeeding,
+                      "Seed every event from the random seed and its event ID.")
+    .SetToBeBroadcasted(false);
+
 // Define the command to set the desired generator
   msg_->DeclareProperty("RegisterGenerator", gen_name_, "");
 
@@ -78,13 +93,13 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   // by the time we process the initialization macro.
 
   // The physics lists are handled with Geant4's own 'factory'
-  physicsList = new G4GenericPhysicsList();
+  G4GenericPhysicsList* physics_list = new G4GenericPhysicsList();
 
   BatchSession* batch = new BatchSession(init_macro.c_str());
   batch->SessionStart();
 
   // Set the physics list in the run manager
-  this->SetUserInitialization(physicsList);
+  run_manager_->SetUserInitialization(physics_list);
 
   // Set the detector construction instance in the run manager
   DetectorConstruction* dc = new DetectorConstruction();
@@ -92,39 +107,26 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
     G4Exception("[NexusApp]", "NexusApp()", FatalException, "A geometry must be specified.");
   }
   dc->SetGeometry(ObjFactory<GeometryBase>::Instance().CreateObject(geo_name_));
-  this->SetUserInitialization(dc);
+  run_manager_->SetUserInitialization(dc);
 
-  // Set the primary generation instance in the run manager
-  PrimaryGeneration* pg = new PrimaryGeneration();
   if (gen_name_ == "") {
     G4Exception("[NexusApp]", "NexusApp()", FatalException, "A generator must be specified.");
   }
-  pg->SetGenerator(ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_));
-  this->SetUserAction(pg);
 
+  // The persistency manager of the master thread owns the output file
   if (pm_name_ == "") {
     G4Exception("[NexusApp]", "NexusApp()", FatalException, "A persistency manager must be specified.");
   }
   PersistencyManagerBase* pm = ObjFactory<PersistencyManagerBase>::Instance().CreateObject(pm_name_);
   pm->SetMacros(init_macro, macros_, delayed_);
 
- // PersistencyManager::Initialize(init_macro, macros_, delayed_);
-
-  // Set the user action instances, if any, in the run manager
-  if (runact_name_ != "")
-    this->SetUserAction(ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_));
-
-  if (evtact_name_ != "")
-    this->SetUserAction(ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_));
-
-  if (stkact_name_ != "")
-    this->SetUserAction(ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_));
-
-  if (trkact_name_ != "")
-    this->SetUserAction(ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_));
-
-  if (stepact_name_ != "")
-    this->SetUserAction(ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_));
+  // Set the action initialization in the run manager. In sequential
+  // mode, the generator and user actions are created right away;
+  // in multithreaded mode, once per worker thread.
+  ActionInitialization* ai =
+    new ActionInitialization(gen_name_, pm_name_, runact_name_, evtact_name_,
+                             stkact_name_, trkact_name_, stepact_name_);
+  run_manager_->SetUserInitialization(ai);
 
   /////////////////////////////////////////////////////////
 
@@ -144,6 +146,7 @@ NexusApp::~NexusApp()
   current->CloseFile();
 
   delete msg_;
+  delete run_manager_;
 }
 
 
@@ -174,7 +177,7 @@ void NexusApp::Initialize()
     ExecuteMacroFile(macros_[i].data());
   }
 
-  G4RunManager::Initialize();
+  run_manager_->Initialize();
 
   for (unsigned int j=0; j<delayed_.size(); j++) {
     ExecuteMacroFile(delayed_[j].data());
@@ -206,6 +209,17 @@ void NexusApp::SetRandomSeed(G4int seed)
   // Set the seed chosen by the user for the pseudo-random number
   // generator unless a negative number was provided, in which case
   // we will set as seed the system time.
-  if (seed < 0) CLHEP::HepRandom::setTheSeed(time(0));
-  else CLHEP::HepRandom::setTheSeed(seed);
+  G4long run_seed = (seed < 0) ? time(0) : seed;
+  CLHEP::HepRandom::setTheSeed(run_seed);
+
+  // Kept so that the events can be seeded from it
+  // and the seed actually used can be recorded
+  EventSeeder::Instance().SetRunSeed(run_seed);
+}
+
+
+
+void NexusApp::SetEventSeeding(G4bool enabled)
+{
+  EventSeeder::Instance().SetEnabled(enabled);
 }
@@ -1,9 +1,10 @@
 // ----------------------------------------------------------------------------
 // nexus | NexusApp.h
 //
-// This class is the run manager of the nexus simulation. It takes care of
-// setting up the simulation (geometry, physics lists, generators, actions),
-// so that it is ready to be run.
+// This class is the application of the nexus simulation. It creates the
+// (sequential or multithreaded) run manager and takes care of setting up
+// the simulation (geometry, physics lists, generators, actions), so that
+// it is ready to be run.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -23,20 +24,27 @@ namespace nexus {
   class ActionsFactory;
 
 
-  /// TODO. CLASS DESCRIPTION
+  /// Application of the nexus simulation. A number of threads larger
+  /// than zero selects the multithreaded run manager (G4TaskRunManager
+  /// by default, G4MTRunManager if the environment variable
+  /// G4RUN_MANAGER_TYPE is set to MT); otherwise, a sequential
+  /// G4RunManager is used.
 
-  class NexusApp: public G4RunManager
+  class NexusApp
   {
   public:
     /// Constructor
-    NexusApp(G4String init_macro);
+    NexusApp(G4String init_macro, G4int nthreads=0);
     /// Destructor
     ~NexusApp();
 
-    virtual void Initialize();
+    void Initialize();
 
-    /// Returns the number of events to be processed in the current run
-    G4int GetNumberOfEventsToBeProcessed() const;
+    /// Runs the given number of events
+    void BeamOn(G4int);
+
+    /// Returns the run manager of the application
+    G4RunManager* GetRunManager() const;
 
   private:
     void RegisterMacro(G4String);
@@ -49,7 +57,12 @@ namespace nexus {
     /// If a negative value is chosen, the system time is set as seed.
     void SetRandomSeed(G4int);
 
+    /// Seed every event from the random seed and its global event ID
+    /// (start_id plus the Geant4 event ID) instead of seeding the run
+    void SetEventSeeding(G4bool);
+
   private:
+    G4RunManager* run_manager_;
     G4GenericMessenger* msg_;
     G4String gen_name_; ///< Name of the chosen primary generator
     G4String geo_name_;  ///< Name of the chosen geometry
@@ -67,8 +80,11 @@ namespace nexus {
 
   // INLINE DEFINITIONS ////////////////////////////////////
 
-  inline G4int NexusApp::GetNumberOfEventsToBeProcessed() const
-  { return numberOfEventToBeProcessed; }
+  inline G4RunManager* NexusApp::GetRunManager() const
+  { return run_manager_; }
+
+  inline void NexusApp::BeamOn(G4int nevents)
+  { run_manager_->BeamOn(nevents); }
 
 } // namespace nexus
 
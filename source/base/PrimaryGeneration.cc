@@ -9,6 +9,9 @@
 
 #include "PrimaryGeneration.h"
 
+#include "EventSeeder.h"
+#include "PersistencyManagerBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4Event.hh>
 
@@ -36,5 +39,15 @@ void PrimaryGeneration::GeneratePrimaries(G4Event* event)
     G4Exception("[PrimaryGeneration]", "GeneratePrimaries()",
                 FatalException, "Generator not set!");
 
+  // The primary generation is the first thing done in an event,
+  // so the whole event follows from the random state set here
+  const EventSeeder& seeder = EventSeeder::Instance();
+  if (seeder.IsEnabled()) {
+    PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    G4long start_id = pm ? pm->GetStartID() : 0;
+    seeder.SeedEvent(start_id + event->GetEventID());
+  }
+
   generator_->GeneratePrimaryVertex(event);
 }
@@ -11,6 +11,7 @@
 #include "Trajectory.h"
 
 #include "TrajectoryPoint.h"
+#include "TrajectoryPointArena.h"
 #include "TrajectoryMap.h"
 
 #include <G4Track.hh>
@@ -20,13 +21,13 @@
 using namespace nexus;
 
 
-G4Allocator<Trajectory> TrjAllocator;
+G4ThreadLocal G4Allocator<Trajectory>* TrjAllocator = 0;
 
 
 Trajectory::Trajectory(const G4Track* track):
   G4VTrajectory(), pdef_(0), trackId_(-1), parentId_(-1),
   initial_time_(0.), final_time_(0), length_(0.), edep_(0.),
-  record_trjpoints_(true), trjpoints_(0)
+  record_trjpoints_(false)
 {
   pdef_     = track->GetDefinition();
   trackId_  = track->GetTrackID();
@@ -42,7 +43,10 @@ Trajectory::Trajectory(const G4Track* track):
   initial_time_ = track->GetGlobalTime();
   initial_volume_ = track->GetVolume()->GetName();
 
-  trjpoints_ = new TrajectoryPointContainer();
+  // Points are only recorded for the selected tracks, and allocated
+  // from the arena of the event instead of one by one
+  record_trjpoints_ = TrajectoryMap::RecordPoints(track);
+  if (record_trjpoints_) arena_ = TrajectoryMap::GetPointArena();
 
   // Add this trajectory in the map, but only if no other
   // trajectory for this track id has been registered yet
@@ -52,7 +56,8 @@ Trajectory::Trajectory(const G4Track* track):
 
 
 
-Trajectory::Trajectory(const Trajectory& other): G4VTrajectory()
+Trajectory::Trajectory(const Trajectory& other): G4VTrajectory(),
+  record_trjpoints_(false)
 {
   pdef_ = other.pdef_;
 }
@@ -61,10 +66,7 @@ Trajectory::Trajectory(const Trajectory& other): G4VTrajectory()
 
 Trajectory::~Trajectory()
 {
-  for (unsigned int i=0; i<trjpoints_->size(); ++i)
-    delete (*trjpoints_)[i];
-  trjpoints_->clear();
-  delete trjpoints_;
+  // The points are released with the arena
 }
 
 
@@ -94,10 +96,8 @@ void Trajectory::AppendStep(const G4Step* step)
 {
   if (!record_trjpoints_) return;
 
-  TrajectoryPoint* point =
-    new TrajectoryPoint(step->GetPostStepPoint()->GetPosition(),
-                        step->GetPostStepPoint()->GetGlobalTime());
-  trjpoints_->push_back(point);
+  trjpoints_.push_back(arena_->New(step->GetPostStepPoint()->GetPosition(),
+                                   step->GetPostStepPoint()->GetGlobalTime()));
 }
 
 
@@ -111,13 +111,15 @@ void Trajectory::MergeTrajectory(G4VTrajectory* second)
   Trajectory* tmp = (Trajectory*) second;
   G4int entries = tmp->GetPointEntries();
 
-  // initial point of the second trajectory should not be merged
+  // initial point of the second trajectory should not be merged.
+  // The points are copied, since the arena of the second trajectory
+  // may be released before this one.
   for (G4int i=1; i<entries ; ++i) {
-    trjpoints_->push_back((*(tmp->trjpoints_))[i]);
+    TrajectoryPoint* point = (TrajectoryPoint*) tmp->trjpoints_[i];
+    trjpoints_.push_back(arena_->New(point->GetPosition(), point->GetTime()));
   }
 
-  delete (*tmp->trjpoints_)[0];
-  tmp->trjpoints_->clear();
+  tmp->trjpoints_.clear();
 }
 
 
@@ -14,6 +14,8 @@
 #include <G4VTrajectory.hh>
 #include <G4Allocator.hh>
 
+#include <memory>
+
 class G4Track;
 class G4ParticleDefinition;
 class G4VTrajectoryPoint;
@@ -21,6 +23,8 @@ class G4VTrajectoryPoint;
 
 namespace nexus {
 
+  class TrajectoryPointArena;
+
   typedef std::vector<G4VTrajectoryPoint*> TrajectoryPointContainer;
 
   class Trajectory: public G4VTrajectory
@@ -53,7 +57,7 @@ namespace nexus {
     G4int GetPDGEncoding () const;
 
     // Return name of the track creator process
-    G4String GetCreatorProcess() const;
+    const G4String& GetCreatorProcess() const;
 
     /// Return id number of the associated track
     G4int GetTrackID() const;
@@ -84,13 +88,13 @@ namespace nexus {
     G4double GetEnergyDeposit() const;
     void SetEnergyDeposit(G4double);
 
-    G4String GetInitialVolume() const;
+    const G4String& GetInitialVolume() const;
 
-    G4String GetFinalVolume() const;
+    const G4String& GetFinalVolume() const;
     void SetFinalVolume(G4String);
 
     // Return name of the track killer process
-    G4String GetFinalProcess() const;
+    const G4String& GetFinalProcess() const;
     void SetFinalProcess(G4String);
 
 
@@ -100,9 +104,10 @@ namespace nexus {
     virtual int GetPointEntries() const;
     /// Return the i-th point in the trajectory
     virtual G4VTrajectoryPoint* GetPoint(G4int i) const;
-    ///
+    /// Add the end point of a step (only if the trajectory records
+    /// points, see TrajectoryMap::RecordPoints)
     virtual void AppendStep(const G4Step*);
-    ///
+    /// Add the points of another trajectory of the same track
     virtual void MergeTrajectory(G4VTrajectory*);
 
     virtual void ShowTrajectory(std::ostream&) const;
@@ -141,7 +146,9 @@ namespace nexus {
 
     G4bool record_trjpoints_;
 
-    TrajectoryPointContainer* trjpoints_;
+    /// Points of the trajectory, owned by the arena of the event
+    TrajectoryPointContainer trjpoints_;
+    std::shared_ptr<TrajectoryPointArena> arena_;
 
 };
 
@@ -149,28 +156,29 @@ namespace nexus {
 
 
 #if defined G4TRACKING_ALLOC_EXPORT
-extern G4DLLEXPORT G4Allocator<nexus::Trajectory> TrjAllocator;
+extern G4DLLEXPORT G4ThreadLocal G4Allocator<nexus::Trajectory>* TrjAllocator;
 #else
-extern G4DLLIMPORT G4Allocator<nexus::Trajectory> TrjAllocator;
+extern G4DLLIMPORT G4ThreadLocal G4Allocator<nexus::Trajectory>* TrjAllocator;
 #endif
 
 
 // INLINE DEFINITIONS //////////////////////////////////////////////
 
 inline void* nexus::Trajectory::operator new(size_t)
-{ return ((void*) TrjAllocator.MallocSingle()); }
+{ if (!TrjAllocator) TrjAllocator = new G4Allocator<nexus::Trajectory>;
+  return ((void*) TrjAllocator->MallocSingle()); }
 
 inline void nexus::Trajectory::operator delete(void* trj)
-{ TrjAllocator.FreeSingle((nexus::Trajectory*) trj); }
+{ TrjAllocator->FreeSingle((nexus::Trajectory*) trj); }
 
 inline G4ParticleDefinition* nexus::Trajectory::GetParticleDefinition()
 { return pdef_; }
 
 inline int nexus::Trajectory::GetPointEntries() const
-{ return trjpoints_->size(); }
+{ return trjpoints_.size(); }
 
 inline G4VTrajectoryPoint* nexus::Trajectory::GetPoint(G4int i) const
-{ return (*trjpoints_)[i]; }
+{ return trjpoints_[i]; }
 
 inline G4ThreeVector nexus::Trajectory::GetInitialMomentum() const
 { return initial_momentum_; }
@@ -213,19 +221,19 @@ inline G4double nexus::Trajectory::GetEnergyDeposit() const { return edep_; }
 
 inline void nexus::Trajectory::SetEnergyDeposit(G4double e) { edep_ = e; }
 
-inline G4String nexus::Trajectory::GetCreatorProcess() const
+inline const G4String& nexus::Trajectory::GetCreatorProcess() const
 { return creator_process_; }
 
-inline G4String nexus::Trajectory::GetFinalProcess() const
+inline const G4String& nexus::Trajectory::GetFinalProcess() const
 { return final_process_; }
 
 inline void nexus::Trajectory::SetFinalProcess(G4String fp)
 { final_process_ = fp; }
 
-inline G4String nexus::Trajectory::GetInitialVolume() const
+inline const G4String& nexus::Trajectory::GetInitialVolume() const
 { return initial_volume_; }
 
-inline G4String nexus::Trajectory::GetFinalVolume() const
+inline const G4String& nexus::Trajectory::GetFinalVolume() const
 { return final_volume_; }
 
 inline void nexus::Trajectory::SetFinalVolume(G4String fv)
@@ -1,17 +1,23 @@
 // ----------------------------------------------------------------------------
 // nexus | TrajectoryMap.cc
 //
-// This class is a container of particle trajectories.
+// This class is a container of particle trajectories. There is one
+// container per thread, holding the trajectories of the current event
+// indexed by track id, together with the arena their points are
+// allocated from and the settings deciding which tracks record points.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 #include "TrajectoryMap.h"
 
+#include "TrajectoryPointArena.h"
+
 #include <G4VTrajectory.hh>
+#include <G4Track.hh>
 
 
-std::map<int, G4VTrajectory*> nexus::TrajectoryMap::map_;
+G4ThreadLocal nexus::TrajectoryMap::ThreadData* nexus::TrajectoryMap::data_ = 0;
 
 
 namespace nexus {
@@ -24,30 +30,106 @@ namespace nexus {
 
   TrajectoryMap::~TrajectoryMap()
   {
-    map_.clear();
+  }
+
+
+
+  TrajectoryMap::ThreadData& TrajectoryMap::Data()
+  {
+    // The data is created the first time it is needed in each thread
+    if (!data_) data_ = new ThreadData;
+    return *data_;
   }
 
 
 
   void TrajectoryMap::Clear()
   {
-    map_.clear();
+    ThreadData& data = Data();
+    data.map.Clear();
+
+    // The arena of the event is retired. It is recycled once no
+    // trajectory uses it anymore (i.e., when the event is deleted).
+    if (data.arena) data.retired.push_back(std::move(data.arena));
+
+    // Keep at most one unused arena around
+    G4bool spare = false;
+    for (auto it = data.retired.begin(); it != data.retired.end(); ) {
+      if (it->use_count() > 1) { ++it; continue; }
+      if (!spare) { spare = true; ++it; }
+      else it = data.retired.erase(it);
+    }
   }
 
 
 
   G4VTrajectory* TrajectoryMap::Get(int trackId)
   {
-    std::map<int, G4VTrajectory*>::iterator it = map_.find(trackId);
-    if (it == map_.end()) return 0;
-    else return it->second;
+    return Data().map.Get(trackId);
   }
 
 
 
   void TrajectoryMap::Add(G4VTrajectory* trj)
   {
-    map_[trj->GetTrackID()] = trj;
+    Data().map.Add(trj->GetTrackID(), trj);
+  }
+
+
+
+  void TrajectoryMap::SetPointRecording(G4bool record)
+  {
+    Data().record_points = record;
+  }
+
+
+
+  void TrajectoryMap::AddPointParticle(const G4String& name)
+  {
+    Data().point_particles.insert(name);
+  }
+
+
+
+  void TrajectoryMap::SetPointMinEnergy(G4double energy)
+  {
+    Data().point_min_energy = energy;
+  }
+
+
+
+  G4bool TrajectoryMap::RecordPoints(const G4Track* track)
+  {
+    const ThreadData& data = Data();
+
+    if (!data.record_points) return false;
+
+    if (!data.point_particles.empty() &&
+        !data.point_particles.count(track->GetDefinition()->GetParticleName()))
+      return false;
+
+    return track->GetVertexKineticEnergy() >= data.point_min_energy;
+  }
+
+
+
+  std::shared_ptr<TrajectoryPointArena> TrajectoryMap::GetPointArena()
+  {
+    ThreadData& data = Data();
+    if (data.arena) return data.arena;
+
+    // Reuse a retired arena that is no longer in use, if any
+    for (auto it = data.retired.begin(); it != data.retired.end(); ++it) {
+      if (it->use_count() == 1) {
+        data.arena = std::move(*it);
+        data.retired.erase(it);
+        data.arena->Reset();
+        return data.arena;
+      }
+    }
+
+    data.arena = std::make_shared<TrajectoryPointArena>();
+    return data.arena;
   }
 
 } // namespace nexus
@@ -1,7 +1,10 @@
 // ----------------------------------------------------------------------------
 // nexus | TrajectoryMap.h
 //
-// This class is a container of particle trajectories.
+// This class is a container of particle trajectories. There is one
+// container per thread, holding the trajectories of the current event
+// indexed by track id, together with the arena their points are
+// allocated from and the settings deciding which tracks record points.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -9,13 +12,23 @@
 #ifndef TRAJECTORY_MAP_H
 #define TRAJECTORY_MAP_H
 
-#include <map>
+#include "DenseIdMap.h"
+
+#include <G4Threading.hh>
+#include <globals.hh>
+
+#include <memory>
+#include <set>
+#include <vector>
 
 class G4VTrajectory;
+class G4Track;
 
 
 namespace nexus {
 
+  class TrajectoryPointArena;
+
   class TrajectoryMap
   {
   public:
@@ -23,9 +36,25 @@ namespace nexus {
     static G4VTrajectory* Get(int trackId);
     /// Add a trajectory to the map
     static void Add(G4VTrajectory*);
-    /// Clear the map
+    /// Clear the map and release the points of the event
     static void Clear();
 
+    /// Enable or disable the recording of trajectory points
+    static void SetPointRecording(G4bool);
+    /// Record points only for the given particles (the method can
+    /// be invoked several times; by default, all particles record them)
+    static void AddPointParticle(const G4String&);
+    /// Record points only for tracks created with at least this
+    /// kinetic energy
+    static void SetPointMinEnergy(G4double);
+    /// Return whether the trajectory of a track must record its points
+    static G4bool RecordPoints(const G4Track*);
+
+    /// Return the arena the points of the current event are
+    /// allocated from. The arena stays alive while any trajectory
+    /// holds it (e.g., events kept by the visualization).
+    static std::shared_ptr<TrajectoryPointArena> GetPointArena();
+
   private:
     // Constructors, destructor and assignement op are hidden
     // so that no instance of the class can be created.
@@ -33,8 +62,23 @@ namespace nexus {
     TrajectoryMap(const TrajectoryMap&);
     ~TrajectoryMap();
 
+    /// Everything the class keeps for a thread
+    struct ThreadData {
+      DenseIdMap<G4VTrajectory> map;
+      std::shared_ptr<TrajectoryPointArena> arena; ///< Arena of this event
+      std::vector<std::shared_ptr<TrajectoryPointArena>> retired;
+      G4bool record_points;
+      std::set<G4String> point_particles;
+      G4double point_min_energy;
+
+      ThreadData(): record_points(false), point_min_energy(0.) {}
+    };
+
+    /// Return the data of the current thread
+    static ThreadData& Data();
+
   private:
-    static std::map<int, G4VTrajectory*> map_;
+    static G4ThreadLocal ThreadData* data_;
   };
 
 } // namespace nexus
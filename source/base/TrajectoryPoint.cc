@@ -12,7 +12,7 @@
 using namespace nexus;
 
 
-G4Allocator<TrajectoryPoint> TrjPointAllocator;
+G4ThreadLocal G4Allocator<TrajectoryPoint>* TrjPointAllocator = 0;
 
 
 TrajectoryPoint::TrajectoryPoint(): 
@@ -52,9 +52,9 @@ namespace nexus {
 } // namespace nexus
 
 #if defined G4TRACKING_ALLOC_EXPORT
-extern G4DLLEXPORT G4Allocator<nexus::TrajectoryPoint> TrjPointAllocator;
+extern G4DLLEXPORT G4ThreadLocal G4Allocator<nexus::TrajectoryPoint>* TrjPointAllocator;
 #else
-extern G4DLLIMPORT G4Allocator<nexus::TrajectoryPoint> TrjPointAllocator;
+extern G4DLLIMPORT G4ThreadLocal G4Allocator<nexus::TrajectoryPoint>* TrjPointAllocator;
 #endif
 
 // INLINE DEFINITIONS //////////////////////////////////////
@@ -65,10 +65,11 @@ namespace nexus {
   {return (this==&other); }
 
   inline void* TrajectoryPoint::operator new(size_t)
-  { return ((void*) TrjPointAllocator.MallocSingle()); }
+  { if (!TrjPointAllocator) TrjPointAllocator = new G4Allocator<TrajectoryPoint>;
+    return ((void*) TrjPointAllocator->MallocSingle()); }
 
   inline void TrajectoryPoint::operator delete(void* tp)
-  { TrjPointAllocator.FreeSingle((TrajectoryPoint*) tp); }
+  { TrjPointAllocator->FreeSingle((TrajectoryPoint*) tp); }
 
   inline const G4ThreeVector TrajectoryPoint::GetPosition() const
   { return position_; }
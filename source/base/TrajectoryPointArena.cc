@@ -0,0 +1,51 @@
+// ----------------------------------------------------------------------------
+// nexus | TrajectoryPointArena.cc
+//
+// This class allocates the trajectory points of an event in large blocks,
+// which are released (or recycled for a later event) all at once.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "TrajectoryPointArena.h"
+
+using namespace nexus;
+
+
+TrajectoryPointArena::TrajectoryPointArena(): block_(0), next_(0)
+{
+}
+
+
+
+TrajectoryPointArena::~TrajectoryPointArena()
+{
+}
+
+
+
+TrajectoryPoint* TrajectoryPointArena::New(const G4ThreeVector& position,
+                                           G4double time)
+{
+  if (blocks_.empty()) {
+    blocks_.emplace_back(new TrajectoryPoint[block_size_]);
+  }
+  else if (next_ == block_size_) {
+    ++block_;
+    next_ = 0;
+    if (block_ == blocks_.size())
+      blocks_.emplace_back(new TrajectoryPoint[block_size_]);
+  }
+
+  TrajectoryPoint* point = &blocks_[block_][next_++];
+  *point = TrajectoryPoint(position, time);
+  return point;
+}
+
+
+
+void TrajectoryPointArena::Reset()
+{
+  block_ = 0;
+  next_  = 0;
+}
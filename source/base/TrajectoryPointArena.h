@@ -0,0 +1,53 @@
+// ----------------------------------------------------------------------------
+// nexus | TrajectoryPointArena.h
+//
+// This class allocates the trajectory points of an event in large blocks,
+// which are released (or recycled for a later event) all at once.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef TRAJECTORY_POINT_ARENA_H
+#define TRAJECTORY_POINT_ARENA_H
+
+#include "TrajectoryPoint.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace nexus {
+
+  class TrajectoryPointArena
+  {
+  public:
+    /// Constructor
+    TrajectoryPointArena();
+    /// Destructor (frees all the points)
+    ~TrajectoryPointArena();
+
+    /// Return a new point with the given position and time
+    TrajectoryPoint* New(const G4ThreeVector& position, G4double time);
+
+    /// Discard all the points, keeping the memory for reuse
+    void Reset();
+
+    /// Return the number of points in use
+    size_t GetSize() const;
+
+  private:
+    static const size_t block_size_ = 4096; ///< Points per block
+
+    std::vector<std::unique_ptr<TrajectoryPoint[]>> blocks_;
+    size_t block_; ///< Block where the next point goes
+    size_t next_;  ///< Position of the next point in the block
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline size_t TrajectoryPointArena::GetSize() const
+  { return block_ * block_size_ + next_; }
+
+} // end namespace nexus
+
+#endif
@@ -19,9 +19,15 @@
 #include <G4ParticleDefinition.hh>
 #include <G4IonTable.hh>
 #include <G4PrimaryVertex.hh>
+#include <G4AutoLock.hh>
 
 using namespace nexus;
 
+namespace {
+  // Ion definitions are shared among threads
+  G4Mutex ion_definition_mutex = G4MUTEX_INITIALIZER;
+}
+
 REGISTER_CLASS(IonGenerator, G4VPrimaryGenerator)
 
 IonGenerator::IonGenerator():
@@ -29,7 +35,7 @@ IonGenerator::IonGenerator():
   atomic_number_(0), mass_number_(0), energy_level_(0.),
   decay_at_time_zero_(true),
   region_(""),
-  msg_(nullptr), geom_(nullptr)
+  msg_(nullptr), geom_(nullptr), pdef_(nullptr)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/IonGenerator/",
                                 "Control commands of the ion gun primary generator.");
@@ -72,6 +78,8 @@ IonGenerator::~IonGenerator()
 
 G4ParticleDefinition* IonGenerator::IonDefinition()
 {
+  G4AutoLock lock(&ion_definition_mutex);
+
   G4ParticleDefinition* pdef =
     G4IonTable::GetIonTable()->GetIon(atomic_number_, mass_number_, energy_level_);
 
@@ -94,11 +102,11 @@ G4ParticleDefinition* IonGenerator::IonDefinition()
 
 void IonGenerator::GeneratePrimaryVertex(G4Event* event)
 {
-  // Pointer declared as static so that it gets allocated only once
-  // (i.e. the ion definition is only looked up in the first event).
-  static G4ParticleDefinition* pdef = IonDefinition();
+  // The ion definition is only looked up in the first event
+  // (of every thread, since each one has its own generator).
+  if (!pdef_) pdef_ = IonDefinition();
   // Create the new primary particle (i.e. the ion)
-  G4PrimaryParticle* ion = new G4PrimaryParticle(pdef);
+  G4PrimaryParticle* ion = new G4PrimaryParticle(pdef_);
 
   // Generate an initial position for the ion using the geometry
   G4ThreeVector position = geom_->GenerateVertex(region_);
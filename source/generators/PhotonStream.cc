@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// nexus | PhotonStream.cc
+//
+// This class holds the optical photons of a point-like source (a photon
+// bomb) that are still to be tracked in the current event. They are
+// injected in the event in chunks, every time the stacking action starts
+// a new stage, so that they never need to be in memory all at once.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhotonStream.h"
+
+#include "SpectrumSampler.h"
+
+#include <G4Track.hh>
+#include <G4TrackVector.hh>
+#include <G4DynamicParticle.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4EventManager.hh>
+#include <G4RandomDirection.hh>
+
+#include <algorithm>
+
+
+namespace nexus {
+
+
+  PhotonStream& PhotonStream::Instance()
+  {
+    static G4ThreadLocal PhotonStream* instance = nullptr;
+    if (!instance) instance = new PhotonStream();
+    return *instance;
+  }
+
+
+
+  PhotonStream::PhotonStream():
+    time_(0.), spectrum_(nullptr), remaining_(0), chunk_(0), marked_(false)
+  {
+  }
+
+
+
+  void PhotonStream::Start(const G4ThreeVector& position, G4double time,
+                           const SpectrumSampler* spectrum,
+                           G4long nphotons, G4long chunk)
+  {
+    position_  = position;
+    time_      = time;
+    spectrum_  = spectrum;
+    remaining_ = nphotons;
+    chunk_     = chunk;
+    marked_    = false;
+  }
+
+
+
+  void PhotonStream::Clear()
+  {
+    remaining_ = 0;
+    marked_    = false;
+  }
+
+
+
+  G4bool PhotonStream::TakeMarker()
+  {
+    if (remaining_ == 0 || marked_) return false;
+    marked_ = true;
+    return true;
+  }
+
+
+
+  void PhotonStream::StackNextChunk()
+  {
+    marked_ = false;
+    if (remaining_ == 0) return;
+
+    G4long n = std::min(remaining_, chunk_);
+    remaining_ -= n;
+
+    G4TrackVector tracks;
+    tracks.reserve(n);
+
+    for (G4long i=0; i<n; i++) {
+      G4ThreeVector direction, polarization;
+      G4double energy;
+      ShootPhoton(*spectrum_, direction, polarization, energy);
+
+      G4DynamicParticle* photon =
+        new G4DynamicParticle(G4OpticalPhoton::Definition(), direction, energy);
+      photon->SetPolarization(polarization);
+
+      // The streamed photons are primary particles like the first chunk
+      G4Track* track = new G4Track(photon, time_, position_);
+      track->SetParentID(0);
+      tracks.push_back(track);
+    }
+
+    // The event manager numbers the tracks and passes
+    // them through the stacking action
+    G4EventManager::GetEventManager()->StackTracks(&tracks);
+  }
+
+
+
+  void PhotonStream::ShootPhoton(const SpectrumSampler& spectrum,
+                                 G4ThreeVector& direction,
+                                 G4ThreeVector& polarization, G4double& energy)
+  {
+    direction    = G4RandomDirection();
+    polarization = G4RandomDirection();
+    energy       = spectrum.Shoot();
+  }
+
+
+} // end namespace nexus
@@ -0,0 +1,68 @@
+// ----------------------------------------------------------------------------
+// nexus | PhotonStream.h
+//
+// This class holds the optical photons of a point-like source (a photon
+// bomb) that are still to be tracked in the current event. They are
+// injected in the event in chunks, every time the stacking action starts
+// a new stage, so that they never need to be in memory all at once.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHOTON_STREAM_H
+#define PHOTON_STREAM_H
+
+#include <G4ThreeVector.hh>
+
+
+namespace nexus {
+
+  class SpectrumSampler;
+
+  class PhotonStream
+  {
+  public:
+    /// Return the stream of the current thread
+    static PhotonStream& Instance();
+
+    /// Set the photons to be streamed in the current event
+    void Start(const G4ThreeVector& position, G4double time,
+               const SpectrumSampler* spectrum, G4long nphotons, G4long chunk);
+    /// Forget the photons not yet streamed
+    void Clear();
+
+    /// Return the number of photons not yet streamed
+    G4long GetRemaining() const;
+
+    /// Return true (once per chunk) if a track must be kept in the
+    /// waiting stack, so that a new stage starts after the chunk
+    G4bool TakeMarker();
+
+    /// Create the next chunk of photons and add them to the stack
+    void StackNextChunk();
+
+    /// Return a random photon direction, polarization and energy
+    static void ShootPhoton(const SpectrumSampler& spectrum,
+                            G4ThreeVector& direction,
+                            G4ThreeVector& polarization, G4double& energy);
+
+  private:
+    PhotonStream();
+
+  private:
+    G4ThreeVector position_;
+    G4double time_;
+    const SpectrumSampler* spectrum_;
+    G4long remaining_;
+    G4long chunk_;
+    G4bool marked_; ///< Has a track of the current chunk been kept waiting?
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4long PhotonStream::GetRemaining() const
+  { return remaining_; }
+
+} // end namespace nexus
+
+#endif
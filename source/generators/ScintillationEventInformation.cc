@@ -0,0 +1,37 @@
+// ----------------------------------------------------------------------------
+// nexus | ScintillationEventInformation.cc
+//
+// This class is the user information attached to the events of the
+// scintillation generator: the number of optical photons generated,
+// whether they are all primary particles or most of them are streamed.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ScintillationEventInformation.h"
+
+#include <G4ios.hh>
+
+
+namespace nexus {
+
+
+  ScintillationEventInformation::ScintillationEventInformation(G4long nphotons):
+    G4VUserEventInformation(), nphotons_(nphotons)
+  {
+  }
+
+
+
+  ScintillationEventInformation::~ScintillationEventInformation()
+  {
+  }
+
+
+
+  void ScintillationEventInformation::Print() const
+  {
+    G4cout << "Scintillation photons generated: " << nphotons_ << G4endl;
+  }
+
+} // end namespace nexus
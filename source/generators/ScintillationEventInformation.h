@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------------
+// nexus | ScintillationEventInformation.h
+//
+// This class is the user information attached to the events of the
+// scintillation generator: the number of optical photons generated,
+// whether they are all primary particles or most of them are streamed.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SCINTILLATION_EVENT_INFORMATION_H
+#define SCINTILLATION_EVENT_INFORMATION_H
+
+#include <G4VUserEventInformation.hh>
+
+
+namespace nexus {
+
+  class ScintillationEventInformation: public G4VUserEventInformation
+  {
+  public:
+    /// Constructor
+    ScintillationEventInformation(G4long nphotons);
+    /// Destructor
+    ~ScintillationEventInformation();
+
+    /// Return the number of photons generated in the event
+    G4long GetNumberOfPhotons() const;
+
+    void Print() const;
+
+  private:
+    G4long nphotons_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4long ScintillationEventInformation::GetNumberOfPhotons() const
+  { return nphotons_; }
+
+} // namespace nexus
+
+#endif
@@ -14,6 +14,10 @@
 #include "GeometryBase.h"
 #include "OpticalMaterialProperties.h"
 #include "FactoryBase.h"
+#include "PhotonStream.h"
+#include "ScintillationEventInformation.h"
+#include "DefaultStackingAction.h"
+#include "SpectrumSampler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4ParticleDefinition.hh>
@@ -21,8 +25,12 @@
 #include <G4ParticleTable.hh>
 #include <G4PrimaryVertex.hh>
 #include <G4Event.hh>
+#include <G4EventManager.hh>
 #include <G4RandomDirection.hh>
 #include <G4OpticalPhoton.hh>
+#include <G4Material.hh>
+
+#include <algorithm>
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
@@ -33,7 +41,8 @@ REGISTER_CLASS(ScintillationGenerator, G4VPrimaryGenerator)
 
 
 ScintillationGenerator::ScintillationGenerator() :
-  G4VPrimaryGenerator(), msg_(0), geom_(0), nphotons_(1000000)
+  G4VPrimaryGenerator(), msg_(0), geom_(0), nphotons_(1000000),
+  chunk_size_(0), events_per_point_(1)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/ScintGenerator/",
     "Control commands of scintillation generator.");
@@ -43,6 +52,27 @@ ScintillationGenerator::ScintillationGenerator() :
 
   msg_->DeclareProperty("nphotons", nphotons_, "Set number of photons");
 
+  msg_->DeclarePropertyWithUnit("grid_min", "mm", grid_min_,
+                                "Set the first point of the grid of vertices.");
+  msg_->DeclarePropertyWithUnit("grid_max", "mm", grid_max_,
+                                "Set the last point of the grid of vertices.");
+  msg_->DeclarePropertyWithUnit("grid_step", "mm", grid_step_,
+                                "Set the step of the grid of vertices "
+                                "(0 for a single point along an axis).");
+
+  G4GenericMessenger::Command& events_cmd =
+    msg_->DeclareProperty("events_per_point", events_per_point_,
+                          "Set the number of events generated in every point of the grid.");
+  events_cmd.SetParameterName("events_per_point", false);
+  events_cmd.SetRange("events_per_point>0");
+
+  G4GenericMessenger::Command& chunk_cmd =
+    msg_->DeclareProperty("chunk_size", chunk_size_,
+                          "Stream the photons in chunks of this size through the "
+                          "stacking action (0 to generate them all as primaries).");
+  chunk_cmd.SetParameterName("chunk_size", false);
+  chunk_cmd.SetRange("chunk_size>=0");
+
   geom_navigator_ =
     G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 
@@ -53,25 +83,70 @@ ScintillationGenerator::ScintillationGenerator() :
 
 ScintillationGenerator::~ScintillationGenerator()
 {
+  for (SpectrumSampler* spectrum: spectra_) delete spectrum;
   delete msg_;
 }
 
 void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   G4ParticleDefinition* particle_definition = G4OpticalPhoton::Definition();
-  // Generate an initial position for the particle using the geometry and set time to 0.
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  // Generate an initial position for the particle using the geometry
+  // (or the grid, if defined) and set time to 0.
+  G4ThreeVector position = (grid_step_.mag2() > 0.) ?
+    GetGridPoint(event->GetEventID()) : geom_->GenerateVertex(region_);
   G4double time = 0.;
 
-  // Energy is sampled from integral (like it is done in G4Scintillation)
-
   G4VPhysicalVolume* vol =
     geom_navigator_->LocateGlobalPointAndSetup(position, 0, false);
-  G4Material* mat = vol->GetLogicalVolume()->GetMaterial();
+  const SpectrumSampler* spectrum =
+    GetSpectrum(vol->GetLogicalVolume()->GetMaterial());
+
+  // In streaming mode, only the first chunk of photons are primary
+  // particles; the rest are added to the event by the stacking action
+  G4long nprimaries = (chunk_size_ > 0) ? std::min(chunk_size_, nphotons_) : nphotons_;
+  if (nprimaries < nphotons_ &&
+      !dynamic_cast<DefaultStackingAction*>
+      (G4EventManager::GetEventManager()->GetUserStackingAction())) {
+    G4Exception("[ScintillationGenerator]", "GeneratePrimaryVertex()", FatalException,
+                "Streaming the photons requires the DefaultStackingAction.");
+  }
+  PhotonStream::Instance().Start(position, time, spectrum,
+                                 nphotons_ - nprimaries, chunk_size_);
+
+  // Create a new vertex
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
+
+  for (G4long i=0; i<nprimaries; i++) {
+    G4ThreeVector direction, polarization;
+    G4double energy;
+    PhotonStream::ShootPhoton(*spectrum, direction, polarization, energy);
+
+    // Create the new primary particle and set it some properties
+    G4PrimaryParticle* particle =
+      new G4PrimaryParticle(particle_definition, energy * direction.x(),
+                            energy * direction.y(), energy * direction.z());
+    particle->SetPolarization(polarization);
+
+    // Add particle to the vertex and this to the event
+    vertex->SetPrimary(particle);
+  }
+  event->AddPrimaryVertex(vertex);
+
+  // The streamed photons are not primary particles: the number of
+  // photons of the event is kept apart (e.g., to normalize light tables)
+  event->SetUserInformation(new ScintillationEventInformation(nphotons_));
+}
+
+const SpectrumSampler* ScintillationGenerator::GetSpectrum(const G4Material* mat)
+{
+  // The spectra are built once per material, the first time it is used
+  size_t index = mat->GetIndex();
+  if (index < spectra_.size() && spectra_[index]) return spectra_[index];
+
   G4MaterialPropertiesTable* mpt = mat->GetMaterialPropertiesTable();
 
   if (!mpt) {
-    G4Exception("[ScintillationGenerator]", "GeneratePrimaryVertex()", FatalException,
+    G4Exception("[ScintillationGenerator]", "GetSpectrum()", FatalException,
                 "Material properties not defined for this material!");
   }
   // Using fast or slow component here is irrelevant, since we're not using time
@@ -79,52 +154,40 @@ void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
   G4MaterialPropertyVector* spectrum = mpt->GetProperty("SCINTILLATIONCOMPONENT1");
 
   if (!spectrum) {
-    G4Exception("[ScintillationGenerator]", "GeneratePrimaryVertex()", FatalException,
+    G4Exception("[ScintillationGenerator]", "GetSpectrum()", FatalException,
                 "Fast time decay constant not defined for this material!");
   }
 
-  G4PhysicsOrderedFreeVector* spectrum_integral =
-    new G4PhysicsOrderedFreeVector();
-  ComputeCumulativeDistribution(*spectrum, *spectrum_integral);
-  G4double sc_max = spectrum_integral->GetMaxValue();
-
-  // Create a new vertex
-  G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
-
-  for ( G4int i = 0; i<nphotons_; i++)
-    {
-      // Generate random direction by default
-      G4ThreeVector _momentum_direction = G4RandomDirection();
-      // Determine photon energy
-      G4double sc_value = G4UniformRand()*sc_max;
-      G4double pmod = spectrum_integral->GetEnergy(sc_value);
-      G4double px = pmod * _momentum_direction.x();
-      G4double py = pmod * _momentum_direction.y();
-      G4double pz = pmod * _momentum_direction.z();
-
-      // Create the new primary particle and set it some properties
-      G4PrimaryParticle* particle =
-        new G4PrimaryParticle(particle_definition, px, py, pz);
-
-      G4ThreeVector polarization = G4RandomDirection();
-      particle->SetPolarization(polarization);
-
-      // Add particle to the vertex and this to the event
-      vertex->SetPrimary(particle);
-    }
-  event->AddPrimaryVertex(vertex);
+  if (index >= spectra_.size()) spectra_.resize(index+1, nullptr);
+  spectra_[index] = new SpectrumSampler(*spectrum);
+  return spectra_[index];
 }
 
-void ScintillationGenerator::ComputeCumulativeDistribution(
-  const G4PhysicsOrderedFreeVector& pdf, G4PhysicsOrderedFreeVector& cdf)
+G4ThreeVector ScintillationGenerator::GetGridPoint(G4int event_id) const
 {
-  G4double sum = 0.;
-  cdf.InsertValues(pdf.Energy(0), sum);
-
-  for (unsigned int i=1; i<pdf.GetVectorLength(); ++i) {
-    G4double area =
-      0.5 * (pdf.Energy(i) - pdf.Energy(i-1)) * (pdf[i] + pdf[i-1]);
-    sum = sum + area;
-    cdf.InsertValues(pdf.Energy(i), sum);
+  // Number of points along every axis
+  G4int n[3];
+  for (G4int i=0; i<3; i++) {
+    n[i] = (grid_step_[i] > 0.) ?
+      G4int((grid_max_[i] - grid_min_[i]) / grid_step_[i] + 0.5) + 1 : 1;
+    if (n[i] < 1) n[i] = 1;
   }
+
+  // Consecutive events are generated in the same point, and
+  // points are swept along x first, then y and then z
+  G4int point = event_id / events_per_point_;
+  if (point >= n[0] * n[1] * n[2]) {
+    G4String msg = "The grid of vertices has only " +
+      std::to_string(n[0] * n[1] * n[2]) + " points; run at most " +
+      std::to_string(n[0] * n[1] * n[2] * events_per_point_) + " events.";
+    G4Exception("[ScintillationGenerator]", "GetGridPoint()", FatalException, msg);
+  }
+
+  G4int ix = point % n[0];
+  G4int iy = (point / n[0]) % n[1];
+  G4int iz = point / (n[0] * n[1]);
+
+  return G4ThreeVector(grid_min_.x() + ix * grid_step_.x(),
+                       grid_min_.y() + iy * grid_step_.y(),
+                       grid_min_.z() + iz * grid_step_.z());
 }
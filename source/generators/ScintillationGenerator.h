@@ -14,14 +14,17 @@
 #include <G4VPrimaryGenerator.hh>
 #include <G4Navigator.hh>
 #include <G4TransportationManager.hh>
-#include <G4PhysicsOrderedFreeVector.hh>
+
+#include <vector>
 
 class G4GenericMessenger;
 class G4Event;
+class G4Material;
 
 namespace nexus {
 
   class GeometryBase;
+  class SpectrumSampler;
 
   class ScintillationGenerator: public G4VPrimaryGenerator
   {
@@ -38,15 +41,27 @@ namespace nexus {
 
   private:
 
-    void ComputeCumulativeDistribution(const G4PhysicsOrderedFreeVector&,
-                                       G4PhysicsOrderedFreeVector&);
+    /// Returns the point of the grid of the given event
+    G4ThreeVector GetGridPoint(G4int event_id) const;
+
+    /// Returns the sampler of the scintillation spectrum of a material
+    const SpectrumSampler* GetSpectrum(const G4Material*);
 
     G4GenericMessenger* msg_;
     G4Navigator* geom_navigator_; ///< Geometry Navigator
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4String region_;
-    G4int    nphotons_;
+    G4long   nphotons_;
+    G4long   chunk_size_; ///< Photons per chunk in streaming mode (0: no streaming)
+
+    /// Sampler of the scintillation spectrum of every material (by index)
+    std::vector<SpectrumSampler*> spectra_;
+
+    // Grid of points swept by consecutive events (e.g., for light
+    // tables), used instead of the region if its step is set
+    G4ThreeVector grid_min_, grid_max_, grid_step_;
+    G4int events_per_point_;
 
   };
 
@@ -10,6 +10,7 @@
 
 #include "MaterialsList.h"
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
 
@@ -246,5 +247,6 @@ void GenericPhotosensor::Construct()
 
     G4SDManager::GetSDMpointer()->AddNewDetector(sensdet);
     sensarea_logic_vol->SetSensitiveDetector(sensdet);
+    SensorRegistry::Instance().RegisterSensorVolume(sensarea_logic_vol);
   }
 }
@@ -28,6 +28,11 @@ namespace nexus {
     /// construction phase
     virtual void Construct() = 0;
 
+    /// The fields (e.g., magnetic) of the geometry must be defined
+    /// in this method, which is invoked in every thread after the
+    /// construction of the volumes
+    virtual void ConstructField();
+
     /// Returns the logical volume representing the geometry
     G4LogicalVolume* GetLogicalVolume() const;
 
@@ -93,6 +98,8 @@ namespace nexus {
 
   inline GeometryBase::~GeometryBase() {}
 
+  inline void GeometryBase::ConstructField() {}
+
   inline G4LogicalVolume* GeometryBase::GetLogicalVolume() const
   { return logicVol_; }
 
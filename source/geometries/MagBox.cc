@@ -25,6 +25,7 @@
 #include <G4FieldManager.hh>
 #include <G4TransportationManager.hh>
 #include <G4SDManager.hh>
+#include <G4AutoDelete.hh>
 #include <G4SystemOfUnits.hh>
 
 
@@ -36,7 +37,8 @@ namespace nexus {
     GeometryBase(),
 
     // Detector dimensions
-    detector_size_ (1.*m)
+    detector_size_ (1.*m),
+    active_logic_(0)
 
   {
     // Messenger
@@ -115,33 +117,23 @@ namespace nexus {
     }
 
 
-    G4LogicalVolume* active_logic =
-      new G4LogicalVolume(active_solid, gas_, "ACTIVE");
-    active_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+    active_logic_ = new G4LogicalVolume(active_solid, gas_, "ACTIVE");
+    active_logic_->SetVisAttributes(G4VisAttributes::GetInvisible());
 
-    new G4PVPlacement(0, G4ThreeVector(0.,0.,0.), active_logic,
+    new G4PVPlacement(0, G4ThreeVector(0.,0.,0.), active_logic_,
 		      "ACTIVE", lab_logic, false, 0, false);
 
     // Set the ACTIVE volume as an ionization sensitive detector
     IonizationSD* ionisd = new IonizationSD("/MAGBOX/ACTIVE");
-    active_logic->SetSensitiveDetector(ionisd);
+    active_logic_->SetSensitiveDetector(ionisd);
     G4SDManager::GetSDMpointer()->AddNewDetector(ionisd);
 
     // Limit the step size in ACTIVE volume for better tracking precision
     std::cout << "*** Maximum Step Size (mm): " << max_step_size_/mm << std::endl;
-    active_logic->SetUserLimits(new G4UserLimits(max_step_size_));
+    active_logic_->SetUserLimits(new G4UserLimits(max_step_size_));
 
-    // Magnetic Field
     std::cout << "*** Magnetic field intensity (tesla): "
               << mag_intensity_/tesla << std::endl;
-    G4UniformMagField* mag_field =
-      new G4UniformMagField(G4ThreeVector(0., 0., mag_intensity_));
-    G4FieldManager* field_mgr =
-      G4TransportationManager::GetTransportationManager()->GetFieldManager();
-    field_mgr->SetDetectorField(mag_field);
-    field_mgr->CreateChordFinder(mag_field);
-    active_logic->SetFieldManager(field_mgr, true);
-
 
     // Vertex Generator
     active_gen_ =
@@ -151,6 +143,20 @@ namespace nexus {
   }
 
 
+  void MagBox::ConstructField()
+  {
+    // Magnetic Field (of this thread)
+    G4UniformMagField* mag_field =
+      new G4UniformMagField(G4ThreeVector(0., 0., mag_intensity_));
+    G4AutoDelete::Register(mag_field);
+    G4FieldManager* field_mgr =
+      G4TransportationManager::GetTransportationManager()->GetFieldManager();
+    field_mgr->SetDetectorField(mag_field);
+    field_mgr->CreateChordFinder(mag_field);
+    active_logic_->SetFieldManager(field_mgr, true);
+  }
+
+
   G4ThreeVector MagBox::GenerateVertex(const G4String& region) const
   {
     G4ThreeVector vertex(0.,0.,0.);
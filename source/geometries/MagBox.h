@@ -33,6 +33,7 @@ namespace nexus {
 
   private:
     void Construct();
+    void ConstructField();
 
   private:
     // Detector dimensions
@@ -40,6 +41,7 @@ namespace nexus {
 
     // ACTIVE gas Xenon
     G4Material* gas_;
+    G4LogicalVolume* active_logic_;
 
     // Parameters
     G4double max_step_size_;  /// Maximum Step Size
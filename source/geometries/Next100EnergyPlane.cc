@@ -80,10 +80,6 @@ namespace nexus {
     ///    in the gas volume, inside the holes excavated in the copper.
 
 
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
 				  "Control commands of geometry Next100.");
@@ -406,6 +402,10 @@ namespace nexus {
 
   G4ThreeVector Next100EnergyPlane::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
     // Copper plate
@@ -416,7 +416,7 @@ namespace nexus {
         vertex = copper_gen_->GenerateVertex("VOLUME");
         G4ThreeVector glob_vtx(vertex);
         glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+        VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != region);
     }
 
@@ -432,7 +432,7 @@ namespace nexus {
         vertex.setZ(vertex.z() + z_translation);
         G4ThreeVector glob_vtx(vertex);
         glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+        VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != region);
     }
 
@@ -76,9 +76,6 @@ namespace nexus {
     // Visibility of the energy plane
     G4bool visibility_, verbosity_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
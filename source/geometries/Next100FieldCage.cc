@@ -13,7 +13,7 @@
 #include "OpticalMaterialProperties.h"
 #include "UniformElectricDriftField.h"
 #include "XenonProperties.h"
-#include "CylinderPointSampler2020.h"
+#include "VoxelRegionSampler.h"
 
 #include <G4Navigator.hh>
 #include <G4SystemOfUnits.hh>
@@ -102,10 +102,6 @@ Next100FieldCage::Next100FieldCage():
   new G4UnitDefinition("kilovolt/cm","kV/cm","Electric field", kilovolt/cm);
   new G4UnitDefinition("mm/sqrt(cm)","mm/sqrt(cm)","Diffusion", mm/sqrt(cm));
 
-  /// Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
   /// Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
                                 "Control commands of geometry Next100.");
@@ -334,9 +330,10 @@ void Next100FieldCage::BuildActive()
 
 
   /// Vertex generator
-  active_gen_ = new CylinderPointSampler2020(0., active_diam_/2., active_length_/2.,
-                                             0., twopi, nullptr,
-                                             G4ThreeVector(0., 0., active_zpos_));
+  active_gen_ = new VoxelRegionSampler(0., active_diam_/2., active_length_/2.,
+                                       G4ThreeVector(0., 0., active_zpos_),
+                                       G4ThreeVector(0., 0., -GetELzCoord()),
+                                       {"ACTIVE"});
 
 
   /// Visibilities
@@ -386,9 +383,10 @@ void Next100FieldCage::BuildCathode()
                     false, 0, false);
 
   // Cathode ring vertex generator
-  cathode_gen_ = new CylinderPointSampler2020(cathode_int_diam_/2.,cathode_ext_diam_/2.,
-                                           cathode_thickn_/2.,0., twopi, nullptr,
-                                           G4ThreeVector(0., 0., cathode_zpos_));
+  cathode_gen_ = new VoxelRegionSampler(cathode_int_diam_/2., cathode_ext_diam_/2., cathode_thickn_/2.,
+                                        G4ThreeVector(0., 0., cathode_zpos_),
+                                        G4ThreeVector(0., 0., -GetELzCoord()),
+                                        {"CATHODE_RING"});
 
 
   /// Visibilities
@@ -452,9 +450,10 @@ void Next100FieldCage::BuildBuffer()
 
   /// Vertex generator
   G4double active_ext_radius = active_diam_/2. / cos(pi/n_panels_);
-  buffer_gen_ = new CylinderPointSampler2020(0., active_ext_radius, buffer_length_/2.,
-                                             0., twopi, nullptr,
-                                             G4ThreeVector(0., 0., buffer_zpos));
+  buffer_gen_ = new VoxelRegionSampler(0., active_ext_radius, buffer_length_/2.,
+                                       G4ThreeVector(0., 0., buffer_zpos),
+                                       G4ThreeVector(0., 0., -GetELzCoord()),
+                                       {"BUFFER"});
 
   /// Vertex generator for all xenon
   G4double xenon_length = el_gap_length_ + active_length_ +
@@ -463,9 +462,10 @@ void Next100FieldCage::BuildBuffer()
                           active_length_ * active_zpos_ +
                           grid_thickn_ * cathode_zpos_ +
                           buffer_length_ * buffer_zpos) / xenon_length;
-  xenon_gen_ = new CylinderPointSampler2020(0., active_ext_radius, xenon_length,
-                                            0., twopi, nullptr,
-                                            G4ThreeVector(0., 0., xenon_zpos));
+  xenon_gen_ = new VoxelRegionSampler(0., active_ext_radius, xenon_length,
+                                      G4ThreeVector(0., 0., xenon_zpos),
+                                      G4ThreeVector(0., 0., -GetELzCoord()),
+                                      {"ACTIVE", "BUFFER", "EL_GAP"});
 
   /// Visibilities
   if (visibility_) {
@@ -569,16 +569,21 @@ void Next100FieldCage::BuildELRegion()
 
   G4ThreeVector el_gap_gen_pos(el_gap_gen_disk_x_, el_gap_gen_disk_y_, el_gap_gen_disk_z);
 
-  el_gap_gen_ = new CylinderPointSampler2020(0., el_gap_gen_disk_diam_/2.,
-                                             el_gap_gen_disk_thickn/2., 0., twopi,
-                                             nullptr, el_gap_gen_pos);
+  el_gap_gen_ = new VoxelRegionSampler(0., el_gap_gen_disk_diam_/2., el_gap_gen_disk_thickn/2.,
+                                       el_gap_gen_pos,
+                                       G4ThreeVector(0., 0., -GetELzCoord()),
+                                       {"EL_GAP"});
 
   // Gate ring vertex generator
-  gate_gen_ = new CylinderPointSampler2020(gate_int_diam_/2., gate_ext_diam_/2., gate_ring_thickn_/2.,
-                                           0., twopi, nullptr, G4ThreeVector(0., 0., gate_zpos_));
+  gate_gen_ = new VoxelRegionSampler(gate_int_diam_/2., gate_ext_diam_/2., gate_ring_thickn_/2.,
+                                     G4ThreeVector(0., 0., gate_zpos_),
+                                     G4ThreeVector(0., 0., -GetELzCoord()),
+                                     {"GATE_RING"});
   // Anode ring vertex generator
-  anode_gen_ = new CylinderPointSampler2020(gate_int_diam_/2., gate_ext_diam_/2., gate_ring_thickn_/2.,
-                                            0., twopi, nullptr, G4ThreeVector(0., 0., anode_zpos_));
+  anode_gen_ = new VoxelRegionSampler(gate_int_diam_/2., gate_ext_diam_/2., gate_ring_thickn_/2.,
+                                      G4ThreeVector(0., 0., anode_zpos_),
+                                      G4ThreeVector(0., 0., -GetELzCoord()),
+                                      {"ANODE_RING"});
 
   /// Visibilities
   if (visibility_) {
@@ -697,9 +702,10 @@ void Next100FieldCage::BuildLightTube()
                          cathode_thickn_ * cathode_gap_zpos +
                          teflon_buffer_length_ * teflon_buffer_zpos_) / teflon_total_length_;
 
-  teflon_gen_ = new CylinderPointSampler2020(active_diam_/2., teflon_ext_radius,
-                                             teflon_total_length_/2., 0., twopi,
-                                             nullptr, G4ThreeVector (0., 0., teflon_zpos));
+  teflon_gen_ = new VoxelRegionSampler(active_diam_/2., teflon_ext_radius, teflon_total_length_/2.,
+                                       G4ThreeVector (0., 0., teflon_zpos),
+                                       G4ThreeVector(0., 0., -GetELzCoord()),
+                                       {"LIGHT_TUBE_DRIFT", "LIGHT_TUBE_BUFFER"});
 
   // Visibilities
   if (visibility_) {
@@ -737,9 +743,10 @@ void Next100FieldCage::BuildFieldCage()
                     hdpe_tube_logic, "HDPE_TUBE", mother_logic_,
                     false, 0, false);
 
-  hdpe_gen_ = new CylinderPointSampler2020(hdpe_tube_int_diam_/2., hdpe_tube_ext_diam_/2.,
-                                           hdpe_length_/2.,0., twopi, nullptr,
-                                           G4ThreeVector(0., 0., hdpe_tube_z_pos));
+  hdpe_gen_ = new VoxelRegionSampler(hdpe_tube_int_diam_/2., hdpe_tube_ext_diam_/2., hdpe_length_/2.,
+                                     G4ThreeVector(0., 0., hdpe_tube_z_pos),
+                                     G4ThreeVector(0., 0., -GetELzCoord()),
+                                     {"HDPE_TUBE"});
 
   G4double active_short_z = 13.5 * mm; //Thickness of holder first holder in the active volume.
   G4double buffer_short_z = 37.  * mm;
@@ -778,9 +785,10 @@ void Next100FieldCage::BuildFieldCage()
   G4double ring_gen_lenght =   first_ring_buff_z_pos + (num_buffer_rings-1)*buffer_ring_dist_
                              - first_ring_drift_z_pos + ring_thickn_;
   G4double ring_gen_zpos = first_ring_drift_z_pos + ring_gen_lenght/2. - ring_thickn_/2.;
-  ring_gen_ = new CylinderPointSampler2020(ring_int_diam_/2., ring_ext_diam_/2., ring_gen_lenght/2.,
-                                           0., twopi, nullptr,
-                                           G4ThreeVector(0., 0., ring_gen_zpos));
+  ring_gen_ = new VoxelRegionSampler(ring_int_diam_/2., ring_ext_diam_/2., ring_gen_lenght/2.,
+                                     G4ThreeVector(0., 0., ring_gen_zpos),
+                                     G4ThreeVector(0., 0., -GetELzCoord()),
+                                     {"FIELD_RING"});
 
   // Ring holders.
   // ACTIVE holders.
@@ -894,10 +902,12 @@ void Next100FieldCage::BuildFieldCage()
                       false, numbering, false);
     numbering +=1;}
 
-  holder_gen_ = new CylinderPointSampler2020(holder_r_ - holder_long_y_/2.,
-                                             holder_r_ + holder_long_y_/2. + holder_short_y_,
-                                             gate_sapphire_wdw_dist_/2., 0., twopi, nullptr,
-                                             G4ThreeVector(0., 0., gate_grid_zpos_ + gate_sapphire_wdw_dist_/2.));
+  holder_gen_ = new VoxelRegionSampler(holder_r_ - holder_long_y_/2.,
+                                       holder_r_ + holder_long_y_/2. + holder_short_y_,
+                                       gate_sapphire_wdw_dist_/2.,
+                                       G4ThreeVector(0., 0., gate_grid_zpos_ + gate_sapphire_wdw_dist_/2.),
+                                       G4ThreeVector(0., 0., -GetELzCoord()),
+                                       {"ACT_HOLDER", "BUFF_HOLDER", "CATHODE_HOLDER"});
 
   /// Visibilities
   if (visibility_) {
@@ -939,137 +949,55 @@ G4ThreeVector Next100FieldCage::GenerateVertex(const G4String& region) const
 {
   G4ThreeVector vertex(0., 0., 0.);
 
+  // The samplers only draw points in the voxels containing the
+  // volumes of each region, built the first time they are used
   if (region == "CENTER") {
     vertex = G4ThreeVector(0., 0., active_zpos_);
   }
 
   else if (region == "ACTIVE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = active_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = active_gen_->GenerateVertex();
   }
 
   else if (region == "CATHODE_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = cathode_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = cathode_gen_->GenerateVertex();
   }
 
   else if (region == "BUFFER") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = buffer_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = buffer_gen_->GenerateVertex();
   }
 
   else if (region == "XENON") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = xenon_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "ACTIVE" &&
-    VertexVolume->GetName() != "BUFFER" &&
-    VertexVolume->GetName() != "EL_GAP");
+    vertex = xenon_gen_->GenerateVertex();
   }
 
   else if (region == "LIGHT_TUBE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = teflon_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "LIGHT_TUBE_DRIFT" &&
-    VertexVolume->GetName() != "LIGHT_TUBE_BUFFER" );
+    vertex = teflon_gen_->GenerateVertex();
   }
 
   else if (region == "HDPE_TUBE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = hdpe_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = hdpe_gen_->GenerateVertex();
   }
 
   else if (region == "EL_GAP") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = el_gap_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = el_gap_gen_->GenerateVertex();
   }
 
   else if (region == "FIELD_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = ring_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = ring_gen_->GenerateVertex();
   }
 
   else if (region == "GATE_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = gate_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = gate_gen_->GenerateVertex();
   }
 
   else if (region == "ANODE_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = anode_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
+    vertex = anode_gen_->GenerateVertex();
   }
 
-  else if (region == "RING_HOLDER"){
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = holder_gen_->GenerateVertex("VOLUME");
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while ((VertexVolume->GetName() != "ACT_HOLDER")  &&
-             (VertexVolume->GetName() != "BUFF_HOLDER") &&
-             (VertexVolume->GetName() != "CATHODE_HOLDER"));
- }
+  else if (region == "RING_HOLDER") {
+    vertex = holder_gen_->GenerateVertex();
+  }
 
   else {
     G4Exception("[Next100FieldCage]", "GenerateVertex()", FatalException,
@@ -20,7 +20,7 @@ class G4Navigator;
 
 namespace nexus {
 
-  class CylinderPointSampler2020;
+  class VoxelRegionSampler;
 
 
   class Next100FieldCage: public GeometryBase
@@ -86,20 +86,17 @@ namespace nexus {
 
 
     // Vertex generators
-    CylinderPointSampler2020* active_gen_;
-    CylinderPointSampler2020* buffer_gen_;
-    CylinderPointSampler2020* teflon_gen_;
-    CylinderPointSampler2020* xenon_gen_;
-    CylinderPointSampler2020* el_gap_gen_;
-    CylinderPointSampler2020* hdpe_gen_;
-    CylinderPointSampler2020* ring_gen_;
-    CylinderPointSampler2020* cathode_gen_;
-    CylinderPointSampler2020* gate_gen_;
-    CylinderPointSampler2020* anode_gen_;
-    CylinderPointSampler2020* holder_gen_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
+    VoxelRegionSampler* active_gen_;
+    VoxelRegionSampler* buffer_gen_;
+    VoxelRegionSampler* teflon_gen_;
+    VoxelRegionSampler* xenon_gen_;
+    VoxelRegionSampler* el_gap_gen_;
+    VoxelRegionSampler* hdpe_gen_;
+    VoxelRegionSampler* ring_gen_;
+    VoxelRegionSampler* cathode_gen_;
+    VoxelRegionSampler* gate_gen_;
+    VoxelRegionSampler* anode_gen_;
+    VoxelRegionSampler* holder_gen_;
 
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
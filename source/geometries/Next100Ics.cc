@@ -37,9 +37,6 @@ namespace nexus {
     visibility_ (0)
   {
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/", "Control commands of geometry Next100.");
     msg_->DeclareProperty("ics_vis", visibility_, "ICS Visibility");
@@ -172,6 +169,10 @@ namespace nexus {
 
   G4ThreeVector Next100Ics::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
     if (region=="ICS"){
@@ -181,7 +182,7 @@ namespace nexus {
 
         G4ThreeVector glob_vtx(vertex);
         glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+        VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "ICS");
     }
 
@@ -80,9 +80,6 @@ namespace nexus {
     msg_->DeclareProperty("shielding_vis", visibility_, "Shielding Visibility");
     msg_->DeclareProperty("shielding_verbosity", verbosity_, "Verbosity");
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
   }
 
 
@@ -575,6 +572,10 @@ namespace nexus {
 
   G4ThreeVector Next100Shielding::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
     if (region == "SHIELDING_LEAD") {
@@ -583,7 +584,7 @@ namespace nexus {
           	vertex = lead_gen_->GenerateVertex("WHOLE_VOL");
           	G4ThreeVector glob_vtx(vertex);
           	glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-          	VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          	VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "LEAD_BOX");
     }
 
@@ -593,7 +594,7 @@ namespace nexus {
           vertex = steel_gen_->GenerateVertex("WHOLE_VOL");
           G4ThreeVector glob_vtx(vertex);
           glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "STEEL_BOX");
     }
 
@@ -603,7 +604,7 @@ namespace nexus {
           vertex = inner_air_gen_->GenerateVertex("INSIDE");
           G4ThreeVector glob_vtx(vertex);
           glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "INNER_AIR");
     }
 
@@ -13,6 +13,7 @@
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 
 #include <G4Box.hh>
 #include <G4LogicalVolume.hh>
@@ -205,6 +206,7 @@ void Next100SiPM::Construct()
 
     G4SDManager::GetSDMpointer()->AddNewDetector(sensdet);
     sens_logic_vol->SetSensitiveDetector(sensdet);
+    SensorRegistry::Instance().RegisterSensorVolume(sens_logic_vol);
   }
 
   // VISIBILITY ////////////////////////////////////////////
@@ -47,10 +47,6 @@ namespace nexus {
     visibility_ (1),
     verbosity_ (0)
   {
-    /// Initializing the geometry navigator (used in vertex generation) ///
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger ///
     msg_ = new G4GenericMessenger(this, "/Geometry/NextDemo/",
                                   "Control commands of the NextDemo geometry.");
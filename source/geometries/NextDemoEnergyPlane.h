@@ -69,9 +69,6 @@ namespace nexus {
     // Visibility and verbosity
     G4bool visibility_, verbosity_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -95,10 +95,6 @@ namespace nexus {
     new G4UnitDefinition("kilovolt/cm","kV/cm","Electric field", kilovolt/cm);
     new G4UnitDefinition("mm/sqrt(cm)","mm/sqrt(cm)","Diffusion", mm/sqrt(cm));
 
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger ///
     msg_ = new G4GenericMessenger(this, "/Geometry/NextDemo/", +
                                   "Control commands of geometry NextDemo.");
@@ -674,6 +670,10 @@ namespace nexus {
 
   G4ThreeVector NextDemoFieldCage::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
      if (region == "ACTIVE") {
@@ -683,7 +683,7 @@ namespace nexus {
          G4ThreeVector glob_vtx(vertex);
          glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
          VertexVolume =
-           geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+           geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
        } while (VertexVolume->GetName() != region);
      }
      else if (region == "EL_GAP") {
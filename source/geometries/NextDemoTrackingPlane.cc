@@ -56,9 +56,6 @@ NextDemoTrackingPlane::NextDemoTrackingPlane():
   msg_->DeclareProperty("tracking_plane_vis", visibility_,
                         "Tracking Plane visibility");
 
-  // Initializing the geometry navigator
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 }
 
 
@@ -280,6 +277,10 @@ void NextDemoTrackingPlane::GenerateBoardPositions(G4double board_posz)
 
 G4ThreeVector NextDemoTrackingPlane::GenerateVertex(const G4String& region) const
 {
+  // Navigators are thread-local: fetch the one of the current thread
+  G4Navigator* geom_navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
   G4ThreeVector vertex;
 
   if (region == "SIPM_BOARD") {
@@ -295,7 +296,7 @@ G4ThreeVector NextDemoTrackingPlane::GenerateVertex(const G4String& region) cons
       G4ThreeVector glob_vtx(vertex);
       glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
       VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+        geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
     } while (VertexVolume->GetName() != region);
   }
 
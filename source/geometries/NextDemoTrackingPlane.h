@@ -62,9 +62,6 @@ namespace nexus {
     G4VPhysicalVolume*  mother_phys_;
 
     G4GenericMessenger* msg_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
   };
 
   inline void NextDemoTrackingPlane::SetConfig(G4String config)
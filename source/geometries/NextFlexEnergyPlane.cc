@@ -71,9 +71,6 @@ NextFlexEnergyPlane::NextFlexEnergyPlane():
   window_thickness_      = 6.0 * mm;
   optical_pad_thickness_ = 1.0 * mm;
 
-  // Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 }
 
 
@@ -538,13 +535,17 @@ G4SubtractionSolid* NextFlexEnergyPlane::MakeHoles(G4Tubs*  ini_solid)
 
 G4ThreeVector NextFlexEnergyPlane::GenerateVertex(const G4String& region) const
 {
+  // Navigators are thread-local: fetch the one of the current thread
+  G4Navigator* geom_navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
   G4ThreeVector vertex;
 
   if (region == "EP_COPPER") {
     G4VPhysicalVolume *VertexVolume;
     do {
       vertex       = copper_gen_->GenerateVertex("VOLUME");
-      VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(vertex, 0, false);
+      VertexVolume = geom_navigator->LocateGlobalPointAndSetup(vertex, 0, false);
     } while (VertexVolume->GetName() != region);
   }
 
@@ -72,9 +72,6 @@ NextFlexTrackingPlane::NextFlexTrackingPlane():
   // Hard-wired dimensions & components
   wls_thickness_  = 1. * um;
 
-  // Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 }
 
 
@@ -488,13 +485,17 @@ void NextFlexTrackingPlane::GenerateSiPMpositions()
 
 G4ThreeVector NextFlexTrackingPlane::GenerateVertex(const G4String& region) const
 {
+  // Navigators are thread-local: fetch the one of the current thread
+  G4Navigator* geom_navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
   G4ThreeVector vertex;
 
   if (region == "TP_COPPER") {
     G4VPhysicalVolume *VertexVolume;
     do {
       vertex       = copper_gen_->GenerateVertex("VOLUME");
-      VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(vertex, 0, false);
+      VertexVolume = geom_navigator->LocateGlobalPointAndSetup(vertex, 0, false);
     } while (VertexVolume->GetName() != region);
   }
 
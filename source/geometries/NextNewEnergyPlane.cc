@@ -54,8 +54,6 @@ namespace nexus {
     visibility_(1)
 
   {
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/", "Control commands of geometry NextNewEnergyPlane.");
     msg_->DeclareProperty("energy_plane_vis", visibility_, "Energy Plane Visibility");
@@ -203,6 +201,10 @@ namespace nexus {
 
   G4ThreeVector NextNewEnergyPlane::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
     /// Carrier Plate   // As it is full of holes, let's get sure vertexes are in the right volume
@@ -215,7 +217,7 @@ namespace nexus {
 	G4ThreeVector glob_vtx(vertex);
 	CalculateGlobalPos(glob_vtx);
 	VertexVolume =
-	  geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+	  geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "CARRIER_PLATE");
     }
     //NextNewPmtEnclosures
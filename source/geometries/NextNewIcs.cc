@@ -51,9 +51,6 @@ namespace nexus {
     center_nozzle_z_pos_ (25. *mm)   //  position of the nozzles (lateral and upper side) with respect to the center of the volume
 
   {
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/", "Control commands of geometry Next100.");
     msg_->DeclareProperty("ics_vis", visibility_, "ICS Visibility");
@@ -174,6 +171,10 @@ namespace nexus {
 
   G4ThreeVector NextNewIcs::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
 
     if (region == "ICS") {
@@ -191,7 +192,7 @@ namespace nexus {
           // First rotate, then shift
           glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
           glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "ICS");
       }
       // Generating in the tread
@@ -202,7 +203,7 @@ namespace nexus {
           G4ThreeVector glob_vtx(vertex);
           glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
           glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "ICS");
       }
     } else {
@@ -61,9 +61,6 @@ namespace nexus {
     CylinderPointSampler* tread_gen_;
     G4double body_perc_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
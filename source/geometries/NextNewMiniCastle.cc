@@ -43,9 +43,6 @@ namespace nexus {
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/",
                                   "Control commands of geometry NextNew.");
     msg_->DeclareProperty("minicastle_vis", visibility_, "NEW mini castle visibility");
-
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
   }
 
   void NextNewMiniCastle::SetLogicalVolume(G4LogicalVolume* mother_logic)
@@ -198,6 +195,10 @@ namespace nexus {
 
   G4ThreeVector NextNewMiniCastle::GenerateVertex(const G4String& region) const
   {
+    // Navigators are thread-local: fetch the one of the current thread
+    G4Navigator* geom_navigator =
+      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+
     G4ThreeVector vertex(0., 0., 0.);
     if (region == "MINI_CASTLE") {
       G4VPhysicalVolume *VertexVolume;
@@ -209,7 +210,7 @@ namespace nexus {
 	// First rotate, then shift
 	glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
 	glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-	VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+	VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "MINI_CASTLE");
     }
     else if (region == "RN_MINI_CASTLE") {
@@ -222,7 +223,7 @@ namespace nexus {
 	  // First rotate, then shift
 	  glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
 	  glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-	  VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+	  VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
 	} while (VertexVolume->GetName() != "MINI_CASTLE");
       }
     else if (region == "MINI_CASTLE_STEEL") {
@@ -235,7 +236,7 @@ namespace nexus {
 	// First rotate, then shift
 	glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
 	glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-	VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+	VertexVolume = geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != "MINI_CASTLE_STEEL");
     }
     else {
@@ -56,9 +56,6 @@ namespace nexus {
     BoxPointSampler* mini_castle_external_surf_gen_;
     BoxPointSampler* steel_box_gen_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Position of the pedestal surface in y
     G4double pedestal_surf_y_;
 
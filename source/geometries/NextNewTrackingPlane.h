@@ -83,9 +83,6 @@ namespace nexus {
     G4double body_perc_;
     G4double flange_perc_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -10,6 +10,7 @@
 #include "MaterialsList.h"
 #include "OpticalMaterialProperties.h"
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 #include "CylinderPointSampler.h"
 #include "Visibilities.h"
 
@@ -157,6 +158,7 @@ namespace nexus {
     pmtsd->SetTimeBinning(binning_);
     G4SDManager::GetSDMpointer()->AddNewDetector(pmtsd);
     photocathode_logic->SetSensitiveDetector(pmtsd);
+    SensorRegistry::Instance().RegisterSensorVolume(photocathode_logic);
 
 
     // VISIBILITIES //////////////////////////////////////////////////
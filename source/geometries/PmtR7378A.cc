@@ -9,6 +9,7 @@
 #include "PmtR7378A.h"
 
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 #include "OpticalMaterialProperties.h"
 #include "MaterialsList.h"
 #include "Visibilities.h"
@@ -116,6 +117,7 @@ namespace nexus {
     pmtsd->SetTimeBinning(100.*nanosecond);
     G4SDManager::GetSDMpointer()->AddNewDetector(pmtsd);
     phcath_logic->SetSensitiveDetector(pmtsd);
+    SensorRegistry::Instance().RegisterSensorVolume(phcath_logic);
 
     // OPTICAL SURFACES //////////////////////////////////////////////
 
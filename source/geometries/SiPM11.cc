@@ -8,6 +8,7 @@
 
 #include "SiPM11.h"
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 #include "MaterialsList.h"
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
@@ -171,6 +172,7 @@ namespace nexus {
 
       G4SDManager::GetSDMpointer()->AddNewDetector(sipmsd);
       active_logic->SetSensitiveDetector(sipmsd);
+      SensorRegistry::Instance().RegisterSensorVolume(active_logic);
     }
 
     // Visibilities
@@ -8,6 +8,7 @@
 
 #include "SiPMSensl.h"
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 #include "MaterialsList.h"
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
@@ -182,6 +183,7 @@ namespace nexus {
 
       G4SDManager::GetSDMpointer()->AddNewDetector(sipmsd);
       active_logic->SetSensitiveDetector(sipmsd);
+      SensorRegistry::Instance().RegisterSensorVolume(active_logic);
     }
 
       // Visibilities
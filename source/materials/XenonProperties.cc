@@ -14,6 +14,9 @@
 #include <G4AnalyticalPolSolver.hh>
 #include <G4MaterialPropertiesTable.hh>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace nexus;
 
 
@@ -287,94 +290,108 @@ std::pair<G4int, G4int> MakeXeDensityDataTable(std::vector<std::vector<G4double>
 }
 
 
-G4double GetGasDensity(G4double pressure, G4double temperature)
-{
-  // Interpolate to calculate the density
-  // at a given pressure and temperature
-  G4double density = 5.324 * kg/m3;
-  std::vector<std::vector<G4double>> data;
-  std::pair<G4int, G4int> nkeys = MakeXeDensityDataTable(data);
-  G4int npressures = nkeys.first;
-  G4int ntemps     = nkeys.second;
+namespace {
 
-  // Find correct interval and use bilinear interpolation
-  G4bool found = false;
-  G4int tcount = 0;
-  G4int pcount = 0;
-  G4int count = 0;
-  G4double t1, t2, p1, p2, d11, d12, d21, d22, d1, d2;
-
-  while (tcount < ntemps-1) {
-    t1 = data[count][0];
-    t2 = data[count+npressures][0];
-
-    if (temperature >= t1 && temperature < t2) {
-      while (pcount < npressures-1) {
-        p1 = data[count][1];
-        p2 = data[count+1][1];
-
-        if (pressure >= p1 && pressure < p2) {
-          d11 = data[count][2];
-          d12 = data[count+1][2];
-          d21 = data[count+npressures][2];
-          d22 = data[count+npressures+1][2];
-
-          density = BilinearInterpolation(temperature, t1, t2,
-            pressure, p1, p2,
-            d11, d12, d21, d22);
-            found = true;
-            break;
-        }
-        pcount++;
-        count++;
-      }
+  // Axis of the xenon density grid. If the values are equally spaced,
+  // the interval of a point is computed directly; otherwise, it is
+  // found with a binary search.
+  struct DensityAxis {
+    std::vector<G4double> values;
+    G4bool regular;
+
+    void Init()
+    {
+      regular = values.size() > 1;
+      G4double step = regular ? values[1] - values[0] : 0.;
+      for (size_t i=2; i<values.size() && regular; ++i)
+        regular = std::abs(values[i] - values[i-1] - step) < 1.e-6 * step;
+    }
 
-      if (!found) {
-        if (pressure == data[count][1]) {
-          d1 = data[count][2];
-          d2 = data[count+npressures][2];
-          density = LinearInterpolation(temperature, t1, t2, d1, d2);
-          found = true;
-        } else {
-          throw "Unknown xenon density for this pressure!";
-        }
+    // Index of the lower edge of the interval containing x,
+    // or -1 if x is out of range. The last value of the axis
+    // belongs to the last interval.
+    G4int Locate(G4double x) const
+    {
+      if (values.size() < 2 || x < values.front() || x > values.back())
+        return -1;
+
+      G4int n = values.size() - 1;
+      G4int i;
+      if (regular) {
+        i = (G4int) ((x - values.front()) / (values[1] - values[0]));
+      } else {
+        i = std::upper_bound(values.begin(), values.end(), x) - values.begin() - 1;
       }
+      return std::min(std::max(i, 0), n - 1);
+    }
+  };
 
-      break;
+  // Density of xenon gas tabulated in a (temperature, pressure) grid
+  struct DensityGrid {
+    DensityAxis temperatures;
+    DensityAxis pressures;
+    std::vector<G4double> densities; // [itemp * npressures + ipress]
+  };
+
+  DensityGrid MakeDensityGrid()
+  {
+    std::vector<std::vector<G4double>> data;
+    MakeXeDensityDataTable(data);
+
+    // The file goes up in pressure, then temperature
+    DensityGrid grid;
+    for (size_t i=0; i<data.size(); ++i) {
+      if (grid.temperatures.values.empty() ||
+          data[i][0] != grid.temperatures.values.back())
+        grid.temperatures.values.push_back(data[i][0]);
+      if (grid.temperatures.values.size() == 1)
+        grid.pressures.values.push_back(data[i][1]);
+      grid.densities.push_back(data[i][2]);
     }
-    tcount++;
-    pcount = 0;
-    count += npressures;
+
+    if (grid.densities.size() !=
+        grid.temperatures.values.size() * grid.pressures.values.size())
+      throw "Xenon density table is not a regular grid";
+
+    grid.temperatures.Init();
+    grid.pressures.Init();
+
+    return grid;
   }
 
-  if (!found) {
-    if (temperature == data[count][0]) {
-      while (pcount< npressures-1) {
-        p1 = data[count][1];
-        p2 = data[count+1][1];
-
-        if (pressure >= p1 && pressure < p2){
-          d1 = data[count][2];
-          d2 = data[count+1][2];
-
-          density = LinearInterpolation(pressure, p1, p2, d1, d2);
-          found = true;
-          break;
-        }
-        pcount++;
-        count++;
-      }
-      if (!found) {
-        if (pressure == data[count][1]) {
-          density = data[count][2];
-          found = true;
-        } else {
-          throw "Unknown xenon density for this pressure!";
-        }
-      }
-    } else {
-        throw "Unknown xenon density for this temperature";
-    }
+  // The table is read only once, the first time a density is requested,
+  // and shared (read-only) by all threads afterwards. (The initialization
+  // of a function-local static is thread-safe.)
+  const DensityGrid& GetDensityGrid()
+  {
+    static const DensityGrid grid = MakeDensityGrid();
+    return grid;
   }
+
+}
+
+
+G4double GetGasDensity(G4double pressure, G4double temperature)
+{
+  // Interpolate to calculate the density
+  // at a given pressure and temperature
+  const DensityGrid& grid = GetDensityGrid();
+
+  G4int it = grid.temperatures.Locate(temperature);
+  if (it < 0) throw "Unknown xenon density for this temperature";
+
+  G4int ip = grid.pressures.Locate(pressure);
+  if (ip < 0) throw "Unknown xenon density for this pressure!";
+
+  const std::vector<G4double>& t = grid.temperatures.values;
+  const std::vector<G4double>& p = grid.pressures.values;
+  G4int np = p.size();
+
+  G4double density =
+    BilinearInterpolation(temperature, t[it], t[it+1],
+                          pressure, p[ip], p[ip+1],
+                          grid.densities[ it   *np + ip], grid.densities[ it   *np + ip+1],
+                          grid.densities[(it+1)*np + ip], grid.densities[(it+1)*np + ip+1]);
+
   return density;
 }
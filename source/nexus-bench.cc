@@ -0,0 +1,207 @@
+// ----------------------------------------------------------------------------
+// nexus | nexus-bench.cc
+//
+// This is the benchmark program of nexus. It runs a workload (a nexus
+// configuration given by its initialization macro) in batch mode and
+// appends its performance figures, as a JSON line, to a results file.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "NexusApp.h"
+#include "BenchmarkEventAction.h"
+#include "PersistencyManagerBase.h"
+
+#include <G4Version.hh>
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+using namespace nexus;
+
+
+void PrintUsage()
+{
+  G4cerr  << "\nUsage: ./nexus-bench [-n number] [-t number] [-w number] "
+          << "[-l label] [-o file] <init_macro>\n" << G4endl;
+  G4cerr  << "Available options:" << G4endl;
+  G4cerr  << "   -n, --nevents         : Number of events to simulate\n"
+          << "   -t, --threads         : Number of worker threads (default: 0, sequential mode)\n"
+          << "   -w, --warmup          : Number of first events of every thread left out of the measurements (default: 1)\n"
+          << "   -l, --label           : Name of the workload (default: the macro name)\n"
+          << "   -o, --output          : File the results are appended to (default: nexus-bench.jsonl)"
+          << G4endl;
+  exit(EXIT_FAILURE);
+}
+
+
+/// Return the value of the sorted times at the given quantile (nearest rank)
+G4double Percentile(const std::vector<G4double>& sorted, G4double q)
+{
+  if (sorted.empty()) return 0.;
+  size_t rank = size_t(std::ceil(q * sorted.size()));
+  return sorted[std::max(rank, size_t(1)) - 1];
+}
+
+
+/// Return the peak resident set size of the process, in megabytes
+G4double PeakRSS()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024. * 1024.); // bytes
+#else
+  return usage.ru_maxrss / 1024.;           // kilobytes
+#endif
+}
+
+
+G4int main(int argc, char** argv)
+{
+  ////////////////////////////////////////////////////////////////////
+  // PARSE COMMAND-LINE OPTIONS
+
+  if (argc < 2) PrintUsage();
+
+  G4int nevents = 0;
+  G4int nthreads = 0;
+  G4int warmup = 1;
+  G4String label = "";
+  G4String results_filename = "nexus-bench.jsonl";
+
+  static struct option long_options[] =
+  {
+    {"nevents", required_argument, 0, 'n'},
+    {"threads", required_argument, 0, 't'},
+    {"warmup",  required_argument, 0, 'w'},
+    {"label",   required_argument, 0, 'l'},
+    {"output",  required_argument, 0, 'o'},
+    {0, 0, 0, 0}
+  };
+
+  int c;
+
+  while (true) {
+
+    opterr = 0;
+    c = getopt_long(argc, argv, "n:t:w:l:o:", long_options, 0);
+
+    if (c==-1) break; // Exit if we are done reading options
+
+    switch (c) {
+
+      case 'n':
+        nevents = atoi(optarg);
+        break;
+
+      case 't':
+        nthreads = atoi(optarg);
+        break;
+
+      case 'w':
+        warmup = atoi(optarg);
+        break;
+
+      case 'l':
+        label = optarg;
+        break;
+
+      case 'o':
+        results_filename = optarg;
+        break;
+
+      case '?':
+        break;
+
+      default:
+        abort();
+    }
+  }
+
+  if (optind == argc) PrintUsage();
+
+  G4String macro_filename = argv[optind];
+  if (macro_filename == "" || nevents <= 0) PrintUsage();
+  if (label == "") label = macro_filename;
+
+  ////////////////////////////////////////////////////////////////////
+  // RUN THE WORKLOAD
+
+  // The event action must be wrapped before the
+  // action initialization is handed to the run manager
+  BenchmarkEventAction::Enable();
+  BenchmarkEventAction::SetWarmup(std::max(warmup, 0));
+
+  NexusApp* app = new NexusApp(macro_filename, nthreads);
+  app->Initialize();
+
+  auto start = std::chrono::steady_clock::now();
+  app->BeamOn(nevents);
+  G4double wall_time =
+    std::chrono::duration<G4double>(std::chrono::steady_clock::now() - start).count();
+
+  PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  G4String output_filename = pm ? pm->GetOutputFile() : "";
+
+  // The output file is complete once the application is deleted
+  delete app;
+
+  ////////////////////////////////////////////////////////////////////
+  // REPORT THE RESULTS
+
+  // The throughput is that of the events timed (after the warm-up),
+  // not of the whole run, which includes its initialization
+  std::vector<G4double> sorted = BenchmarkEventAction::GetEventTimes();
+  std::sort(sorted.begin(), sorted.end());
+  G4double timed_wall_time = BenchmarkEventAction::GetTimedWallTime();
+  G4double events_per_s = (timed_wall_time > 0.) ? sorted.size() / timed_wall_time : 0.;
+
+  G4double mean = 0.;
+  for (G4double t: sorted) mean += t;
+  if (!sorted.empty()) mean /= sorted.size();
+
+  G4double output_bytes = 0.;
+  struct stat output_stat;
+  if (output_filename != "" && stat(output_filename.c_str(), &output_stat) == 0)
+    output_bytes = output_stat.st_size;
+
+  std::ofstream results(results_filename, std::ios::app);
+  if (!results) {
+    G4Exception("[nexus-bench]", "main()", FatalException,
+                ("Cannot open results file " + results_filename).c_str());
+  }
+
+  // Event times are given in milliseconds
+  results << std::setprecision(6)
+          << "{\"workload\": \"" << label << "\""
+          << ", \"macro\": \"" << macro_filename << "\""
+          << ", \"geant4\": " << G4VERSION_NUMBER
+          << ", \"threads\": " << nthreads
+          << ", \"events\": " << nevents
+          << ", \"timed_events\": " << sorted.size()
+          << ", \"wall_time_s\": " << wall_time
+          << ", \"timed_wall_time_s\": " << timed_wall_time
+          << ", \"events_per_s\": " << events_per_s
+          << ", \"event_time_ms\": {"
+          << "\"mean\": " << mean * 1.e3
+          << ", \"p50\": " << Percentile(sorted, 0.50) * 1.e3
+          << ", \"p90\": " << Percentile(sorted, 0.90) * 1.e3
+          << ", \"p99\": " << Percentile(sorted, 0.99) * 1.e3
+          << ", \"max\": " << (sorted.empty() ? 0. : sorted.back()) * 1.e3
+          << "}"
+          << ", \"peak_rss_mb\": " << PeakRSS()
+          << ", \"output_bytes\": " << std::setprecision(15) << output_bytes
+          << ", \"output_bytes_per_event\": " << output_bytes / nevents
+          << "}" << std::endl;
+
+  return EXIT_SUCCESS;
+}
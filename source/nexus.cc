@@ -19,11 +19,12 @@ using namespace nexus;
 
 void PrintUsage()
 {
-  G4cerr  << "\nUsage: ./nexus [-b|i] [-n number] <init_macro>\n" << G4endl;
+  G4cerr  << "\nUsage: ./nexus [-b|i] [-n number] [-t number] <init_macro>\n" << G4endl;
   G4cerr  << "Available options:" << G4endl;
   G4cerr  << "   -b, --batch           : Run in batch mode (default)\n"
           << "   -i, --interactive     : Run in interactive mode\n"
-          << "   -n, --nevents         : Number of events to simulate"
+          << "   -n, --nevents         : Number of events to simulate\n"
+          << "   -t, --threads         : Number of worker threads (default: 0, sequential mode)"
           << G4endl;
   exit(EXIT_FAILURE);
 }
@@ -40,12 +41,14 @@ G4int main(int argc, char** argv)
 
   G4bool batch = true;
   G4int nevents = 0;
+  G4int nthreads = 0;
 
   static struct option long_options[] =
   {
     {"batch",       no_argument,       0, 'b'},
     {"interactive", no_argument,       0, 'i'},
     {"nevents",       required_argument, 0, 'n'},
+    {"threads",       required_argument, 0, 't'},
     {0, 0, 0, 0}
   };
 
@@ -55,7 +58,7 @@ G4int main(int argc, char** argv)
 
     //  int option_index = 0;
     opterr = 0;
-    c = getopt_long(argc, argv, "bin:", long_options, 0);
+    c = getopt_long(argc, argv, "bin:t:", long_options, 0);
 
     if (c==-1) break; // Exit if we are done reading options
 
@@ -73,6 +76,10 @@ G4int main(int argc, char** argv)
         nevents = atoi(optarg);
         break;
 
+      case 't':
+        nthreads = atoi(optarg);
+        break;
+
       case '?':
         break;
 
@@ -97,7 +104,7 @@ G4int main(int argc, char** argv)
 
   ////////////////////////////////////////////////////////////////////
 
-  NexusApp* app = new NexusApp(macro_filename);
+  NexusApp* app = new NexusApp(macro_filename, nthreads);
   app->Initialize();
 
   G4UImanager* UI = G4UImanager::GetUIpointer();
@@ -1,7 +1,10 @@
 // ----------------------------------------------------------------------------
 // nexus | HDF5Writer.cc
 //
-// This class writes the h5 nexus output file.
+// This class writes the h5 nexus output file. The rows of the tables
+// are buffered in memory and written in batches, optionally by a separate
+// writer thread (asynchronous mode). A writer with no file open just
+// buffers the rows, to be appended later to the one owning the file.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -19,14 +22,31 @@
 using namespace nexus;
 
 
+namespace {
+  // Maximum number of batches waiting for the writer thread
+  const size_t max_queue_size = 16;
+
+  template <typename T>
+  void MoveRows(std::vector<T>& from, std::vector<T>& to)
+  {
+    if (to.empty()) to.swap(from);
+    else to.insert(to.end(), from.begin(), from.end());
+    from.clear();
+  }
+}
+
 HDF5Writer::HDF5Writer():
-  file_(0), irun_(0), ismp_(0), ihit_(0),
-  ipart_(0), ipos_(0), istep_(0)
+  file_(0), isOpen_(false), stepTable_(0), trjPointTable_(0), stringDictTable_(0),
+  lightPointTable_(0), lightProbTable_(0), lightProfileTable_(0),
+  irun_(0), ismp_(0), ihit_(0), ipart_(0), ipos_(0), istep_(0),
+  itrjpoint_(0), istring_(0), ilightpoint_(0), ilightprob_(0), ilightprofile_(0),
+  string_dict_(false), async_(false), stop_(false)
 {
 }
 
 HDF5Writer::~HDF5Writer()
 {
+  if (writer_.joinable()) StopWriterThread();
 }
 
 void HDF5Writer::Open(std::string fileName, bool debug)
@@ -52,30 +72,236 @@ void HDF5Writer::Open(std::string fileName, bool debug)
   hitInfoTable_ = createTable(group, hit_info_table_name, memtypeHitInfo_);
 
   std::string particle_info_table_name = "particles";
-  memtypeParticleInfo_ = createParticleInfoType();
+  if (string_dict_) memtypeParticleInfo_ = createParticleCodeType();
+  else              memtypeParticleInfo_ = createParticleInfoType();
   particleInfoTable_ = createTable(group, particle_info_table_name, memtypeParticleInfo_);
 
+  if (string_dict_) {
+    std::string string_dict_table_name = "string_dict";
+    memtypeStringDict_ = createStringDictType();
+    stringDictTable_ = createTable(group, string_dict_table_name, memtypeStringDict_);
+  }
+
   std::string sns_pos_table_name = "sns_positions";
   memtypeSnsPos_ = createSensorPosType();
   snsPosTable_ = createTable(group, sns_pos_table_name, memtypeSnsPos_);
 
-  if (debug) {
-    std::string debug_group_name = "/DEBUG";
-    size_t debug_group = createGroup(file_, debug_group_name);
-    std::string step_table_name = "steps";
-    memtypeStep_ = createStepType();
-    stepTable_   = createTable(debug_group, step_table_name, memtypeStep_);
-  }
+  if (debug) CreateStepTable();
 
   isOpen_ = true;
 }
 
+void HDF5Writer::CreateStepTable()
+{
+  std::string debug_group_name = "/DEBUG";
+  size_t debug_group = createGroup(file_, debug_group_name);
+  std::string step_table_name = "steps";
+  if (string_dict_) memtypeStep_ = createStepCodeType();
+  else              memtypeStep_ = createStepType();
+  stepTable_   = createTable(debug_group, step_table_name, memtypeStep_);
+}
+
+void HDF5Writer::CreateTrajectoryPointTable()
+{
+  std::string table_name = "trajectory_points";
+  memtypeTrjPoint_ = createTrajectoryPointType();
+  hid_t group = H5Gopen2(file_, "/MC", H5P_DEFAULT);
+  trjPointTable_ = createTable(group, table_name, memtypeTrjPoint_);
+  H5Gclose(group);
+}
+
+void HDF5Writer::CreateLightTables()
+{
+  std::string group_name = "/LightTable";
+  size_t group = createGroup(file_, group_name);
+
+  std::string point_table_name = "points";
+  memtypeLightPoint_ = createLightPointType();
+  lightPointTable_ = createTable(group, point_table_name, memtypeLightPoint_);
+
+  std::string prob_table_name = "probabilities";
+  memtypeLightProb_ = createLightProbabilityType();
+  lightProbTable_ = createTable(group, prob_table_name, memtypeLightProb_);
+
+  std::string profile_table_name = "time_profiles";
+  memtypeLightProfile_ = createLightProfileType();
+  lightProfileTable_ = createTable(group, profile_table_name, memtypeLightProfile_);
+}
+
 void HDF5Writer::Close()
 {
+  if (!isOpen_) return;
+
+  Flush();
+  if (writer_.joinable()) StopWriterThread();
+
   isOpen_=false;
   H5Fclose(file_);
 }
 
+void HDF5Writer::Append(HDF5Writer& other)
+{
+  RowBuffer& rows = other.buffer_;
+
+  // The new strings of the other writer are added to the dictionary
+  // of this one, and its codes are translated into the codes in file
+  for (const string_dict_t& entry: rows.strings)
+    other.file_codes_.push_back(Intern(entry.value));
+  rows.strings.clear();
+
+  const std::vector<int32_t>& codes = other.file_codes_;
+
+  for (particle_code_t& row: rows.particle_codes) {
+    row.particle_name  = codes[row.particle_name];
+    row.initial_volume = codes[row.initial_volume];
+    row.final_volume   = codes[row.final_volume];
+    row.creator_proc   = codes[row.creator_proc];
+    row.final_proc     = codes[row.final_proc];
+  }
+
+  for (step_code_t& row: rows.step_codes) {
+    row.particle_name  = codes[row.particle_name];
+    row.initial_volume = codes[row.initial_volume];
+    row.final_volume   = codes[row.final_volume];
+    row.proc_name      = codes[row.proc_name];
+  }
+
+  MoveRows(rows.runs,           buffer_.runs);
+  MoveRows(rows.sns_data,       buffer_.sns_data);
+  MoveRows(rows.hits,           buffer_.hits);
+  MoveRows(rows.particles,      buffer_.particles);
+  MoveRows(rows.sns_pos,        buffer_.sns_pos);
+  MoveRows(rows.steps,          buffer_.steps);
+  MoveRows(rows.trj_points,     buffer_.trj_points);
+  MoveRows(rows.particle_codes, buffer_.particle_codes);
+  MoveRows(rows.step_codes,     buffer_.step_codes);
+  MoveRows(rows.light_points,   buffer_.light_points);
+  MoveRows(rows.light_probs,    buffer_.light_probs);
+  MoveRows(rows.light_profiles, buffer_.light_profiles);
+}
+
+void HDF5Writer::SetAsync(bool async)
+{
+  // Pending batches are written before going back to synchronous mode
+  if (!async && writer_.joinable()) {
+    Flush();
+    StopWriterThread();
+  }
+  async_ = async;
+}
+
+void HDF5Writer::SetStringDictionary(bool string_dict)
+{
+  string_dict_ = string_dict;
+}
+
+int32_t HDF5Writer::Intern(const char* str)
+{
+  auto result = string_codes_.emplace(str, string_codes_.size());
+  if (result.second) {
+    string_dict_t entry;
+    entry.code = result.first->second;
+    memset(entry.value, 0, STRLEN);
+    strncpy(entry.value, str, STRLEN-1);
+    buffer_.strings.push_back(entry);
+    CheckBufferSize(buffer_.strings.size());
+  }
+  return result.first->second;
+}
+
+void HDF5Writer::Flush()
+{
+  if (!async_) {
+    WriteBuffer(buffer_);
+    buffer_ = RowBuffer();
+    return;
+  }
+
+  if (!writer_.joinable()) {
+    stop_ = false;
+    writer_ = std::thread(&HDF5Writer::WriterLoop, this);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    queue_not_full_.wait(lock, [this]{ return queue_.size() < max_queue_size; });
+    queue_.push_back(std::move(buffer_));
+  }
+  queue_not_empty_.notify_one();
+
+  buffer_ = RowBuffer();
+}
+
+void HDF5Writer::WriterLoop()
+{
+  while (true) {
+    RowBuffer rows;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_not_empty_.wait(lock, [this]{ return !queue_.empty() || stop_; });
+      // Only finish once all the pending batches are written
+      if (queue_.empty()) return;
+      rows = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    queue_not_full_.notify_one();
+
+    WriteBuffer(rows);
+  }
+}
+
+void HDF5Writer::StopWriterThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  queue_not_empty_.notify_one();
+  writer_.join();
+}
+
+void HDF5Writer::WriteBuffer(RowBuffer& rows)
+{
+  // In multithreaded mode the stepping action is only known once
+  // the worker threads start, after the file was opened
+  if ((!rows.steps.empty() || !rows.step_codes.empty()) && !stepTable_)
+    CreateStepTable();
+  // The trajectory points table only exists if points are stored
+  if (!rows.trj_points.empty() && !trjPointTable_) CreateTrajectoryPointTable();
+  // Likewise, the light tables only exist in light-table mode
+  if (!rows.light_points.empty() && !lightPointTable_) CreateLightTables();
+
+  WriteRows(rows.strings, stringDictTable_, memtypeStringDict_, istring_);
+  WriteRows(rows.runs, runTable_, memtypeRun_, irun_);
+  WriteRows(rows.sns_data, snsDataTable_, memtypeSnsData_, ismp_);
+  WriteRows(rows.hits, hitInfoTable_, memtypeHitInfo_, ihit_);
+  WriteRows(rows.particles, particleInfoTable_, memtypeParticleInfo_, ipart_);
+  WriteRows(rows.particle_codes, particleInfoTable_, memtypeParticleInfo_, ipart_);
+  WriteRows(rows.sns_pos, snsPosTable_, memtypeSnsPos_, ipos_);
+  WriteRows(rows.steps, stepTable_, memtypeStep_, istep_);
+  WriteRows(rows.step_codes, stepTable_, memtypeStep_, istep_);
+  WriteRows(rows.trj_points, trjPointTable_, memtypeTrjPoint_, itrjpoint_);
+  WriteRows(rows.light_points, lightPointTable_, memtypeLightPoint_, ilightpoint_);
+  WriteRows(rows.light_probs, lightProbTable_, memtypeLightProb_, ilightprob_);
+  WriteRows(rows.light_profiles, lightProfileTable_, memtypeLightProfile_, ilightprofile_);
+}
+
+template <typename T>
+void HDF5Writer::WriteRows(const std::vector<T>& rows, size_t table,
+                           size_t memtype, size_t& counter)
+{
+  if (rows.empty()) return;
+
+  writeRows(rows.data(), rows.size(), table, memtype, counter);
+  counter += rows.size();
+}
+
+void HDF5Writer::CheckBufferSize(size_t nrows)
+{
+  // Without a file, the rows are kept until appended to another writer
+  if (isOpen_ && nrows == CHUNKSIZE) Flush();
+}
+
 void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
 {
   run_info_t runData;
@@ -83,9 +309,8 @@ void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
   memset(runData.param_value, 0, CONFLEN);
   strcpy(runData.param_key, param_key);
   strcpy(runData.param_value, param_value);
-  writeRun(&runData, runTable_, memtypeRun_, irun_);
-
-  irun_++;
+  buffer_.runs.push_back(runData);
+  CheckBufferSize(buffer_.runs.size());
 }
 
 
@@ -96,9 +321,8 @@ void HDF5Writer::WriteSensorDataInfo(int evt_number, unsigned int sensor_id, uns
   snsData.sensor_id = sensor_id;
   snsData.time_bin = time_bin;
   snsData.charge = charge;
-  writeSnsData(&snsData, snsDataTable_, memtypeSnsData_, ismp_);
-
-  ismp_++;
+  buffer_.sns_data.push_back(snsData);
+  CheckBufferSize(buffer_.sns_data.size());
 }
 
 void HDF5Writer::WriteHitInfo(int evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label)
@@ -114,13 +338,44 @@ void HDF5Writer::WriteHitInfo(int evt_number, int particle_indx, int hit_indx, f
   strcpy(trueInfo.label, label);
   trueInfo.particle_id = particle_indx;
   trueInfo.hit_id = hit_indx;
-  writeHit(&trueInfo,  hitInfoTable_, memtypeHitInfo_, ihit_);
-
-  ihit_++;
+  buffer_.hits.push_back(trueInfo);
+  CheckBufferSize(buffer_.hits.size());
 }
 
 void HDF5Writer::WriteParticleInfo(int evt_number, int particle_indx, const char* particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume, const char* final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc, const char* final_proc)
 {
+  if (string_dict_) {
+    particle_code_t row;
+    row.event_id = evt_number;
+    row.particle_id = particle_indx;
+    row.particle_name = Intern(particle_name);
+    row.primary = primary;
+    row.mother_id = mother_id;
+    row.initial_x = initial_vertex_x;
+    row.initial_y = initial_vertex_y;
+    row.initial_z = initial_vertex_z;
+    row.initial_t = initial_vertex_t;
+    row.final_x = final_vertex_x;
+    row.final_y = final_vertex_y;
+    row.final_z = final_vertex_z;
+    row.final_t = final_vertex_t;
+    row.initial_volume = Intern(initial_volume);
+    row.final_volume = Intern(final_volume);
+    row.initial_momentum_x = ini_momentum_x;
+    row.initial_momentum_y = ini_momentum_y;
+    row.initial_momentum_z = ini_momentum_z;
+    row.final_momentum_x = final_momentum_x;
+    row.final_momentum_y = final_momentum_y;
+    row.final_momentum_z = final_momentum_z;
+    row.kin_energy = kin_energy;
+    row.length = length;
+    row.creator_proc = Intern(creator_proc);
+    row.final_proc = Intern(final_proc);
+    buffer_.particle_codes.push_back(row);
+    CheckBufferSize(buffer_.particle_codes.size());
+    return;
+  }
+
   particle_info_t trueInfo;
   trueInfo.event_id = evt_number;
   trueInfo.particle_id = particle_indx;
@@ -152,9 +407,8 @@ void HDF5Writer::WriteParticleInfo(int evt_number, int particle_indx, const char
   strcpy(trueInfo.creator_proc, creator_proc);
   memset(trueInfo.final_proc, 0, STRLEN);
   strcpy(trueInfo.final_proc, final_proc);
-  writeParticle(&trueInfo,  particleInfoTable_, memtypeParticleInfo_, ipart_);
-
-  ipart_++;
+  buffer_.particles.push_back(trueInfo);
+  CheckBufferSize(buffer_.particles.size());
 }
 
 void HDF5Writer::WriteSensorPosInfo(unsigned int sensor_id, const char* sensor_name, float x, float y, float z)
@@ -166,9 +420,8 @@ void HDF5Writer::WriteSensorPosInfo(unsigned int sensor_id, const char* sensor_n
   snsPos.x = x;
   snsPos.y = y;
   snsPos.z = z;
-  writeSnsPos(&snsPos, snsPosTable_, memtypeSnsPos_, ipos_);
-
-  ipos_++;
+  buffer_.sns_pos.push_back(snsPos);
+  CheckBufferSize(buffer_.sns_pos.size());
 }
 
 void HDF5Writer::WriteStep(int evt_number,
@@ -180,6 +433,26 @@ void HDF5Writer::WriteStep(int evt_number,
                            float initial_x, float initial_y, float initial_z,
                            float   final_x, float   final_y, float   final_z)
 {
+  if (string_dict_) {
+    step_code_t row;
+    row.event_id       = evt_number;
+    row.particle_id    = particle_id;
+    row.particle_name  = Intern(particle_name);
+    row.step_id        = step_id;
+    row.initial_volume = Intern(initial_volume);
+    row.final_volume   = Intern(final_volume);
+    row.proc_name      = Intern(proc_name);
+    row.initial_x      = initial_x;
+    row.initial_y      = initial_y;
+    row.initial_z      = initial_z;
+    row.final_x        = final_x;
+    row.final_y        = final_y;
+    row.final_z        = final_z;
+    buffer_.step_codes.push_back(row);
+    CheckBufferSize(buffer_.step_codes.size());
+    return;
+  }
+
   step_info_t step;
   step.event_id    = evt_number;
   step.particle_id = particle_id;
@@ -199,7 +472,57 @@ void HDF5Writer::WriteStep(int evt_number,
   step.  final_y   =   final_y;
   step.  final_z   =   final_z;
 
-  writeStep(&step, stepTable_, memtypeStep_, istep_);
+  buffer_.steps.push_back(step);
+  CheckBufferSize(buffer_.steps.size());
+}
 
-  istep_++;
+void HDF5Writer::WriteTrajectoryPoint(int evt_number, int particle_id, int point_id,
+                                      float dx, float dy, float dz, float dt)
+{
+  trj_point_t point;
+  point.event_id    = evt_number;
+  point.particle_id = particle_id;
+  point.point_id    = point_id;
+  point.dx = dx;
+  point.dy = dy;
+  point.dz = dz;
+  point.dt = dt;
+  buffer_.trj_points.push_back(point);
+  CheckBufferSize(buffer_.trj_points.size());
+}
+
+void HDF5Writer::WriteLightTablePoint(int point_id, float x, float y, float z,
+                                      int nevents, int64_t nphotons)
+{
+  light_point_t point;
+  point.point_id = point_id;
+  point.x = x;
+  point.y = y;
+  point.z = z;
+  point.nevents  = nevents;
+  point.nphotons = nphotons;
+  buffer_.light_points.push_back(point);
+  CheckBufferSize(buffer_.light_points.size());
+}
+
+void HDF5Writer::WriteLightTableProbability(int point_id, int sensor_id, float probability)
+{
+  light_prob_t prob;
+  prob.point_id    = point_id;
+  prob.sensor_id   = sensor_id;
+  prob.probability = probability;
+  buffer_.light_probs.push_back(prob);
+  CheckBufferSize(buffer_.light_probs.size());
+}
+
+void HDF5Writer::WriteLightTableProfile(int point_id, int sensor_id, int time_bin,
+                                        float probability)
+{
+  light_profile_t profile;
+  profile.point_id    = point_id;
+  profile.sensor_id   = sensor_id;
+  profile.time_bin    = time_bin;
+  profile.probability = probability;
+  buffer_.light_profiles.push_back(profile);
+  CheckBufferSize(buffer_.light_profiles.size());
 }
@@ -1,7 +1,10 @@
 // ----------------------------------------------------------------------------
 // nexus | HDF5Writer.cc
 //
-// This class writes the h5 nexus output file.
+// This class writes the h5 nexus output file. The rows of the tables
+// are buffered in memory and written in batches, optionally by a separate
+// writer thread (asynchronous mode). A writer with no file open just
+// buffers the rows, to be appended later to the one owning the file.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -13,6 +16,13 @@
 
 #include <hdf5.h>
 #include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace nexus {
 
@@ -27,9 +37,25 @@ namespace nexus {
     /// open file
     void Open(std::string filename, bool debug);
 
-    /// close file
+    /// close file, writing first any buffered rows
     void Close();
 
+    /// write to file the rows buffered so far (e.g., at the end of an event).
+    /// In asynchronous mode, they are handed to the writer thread instead,
+    /// waiting if it is already lagging behind by too many batches.
+    void Flush();
+
+    /// move the rows buffered in a writer with no file open (e.g., those
+    /// of an event, filled in a worker thread) to the buffer of this one
+    void Append(HDF5Writer& rows);
+
+    /// enable or disable the writer thread
+    void SetAsync(bool);
+
+    /// store the strings of the particle and step tables as codes
+    /// defined in a dictionary table (to be set before opening the file)
+    void SetStringDictionary(bool);
+
     void WriteRunInfo(const char* param_key, const char* param_value);
     void WriteSensorDataInfo(int evt_number, unsigned int sensor_id, unsigned int time_bin, unsigned int charge);
     void WriteHitInfo(int evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label);
@@ -43,6 +69,54 @@ namespace nexus {
                    const char*      proc_name,
                    float initial_x, float initial_y, float initial_z,
                    float   final_x, float   final_y, float   final_z);
+    void WriteTrajectoryPoint(int evt_number, int particle_id, int point_id,
+                              float dx, float dy, float dz, float dt);
+    void WriteLightTablePoint(int point_id, float x, float y, float z,
+                              int nevents, int64_t nphotons);
+    void WriteLightTableProbability(int point_id, int sensor_id, float probability);
+    void WriteLightTableProfile(int point_id, int sensor_id, int time_bin,
+                                float probability);
+
+  private:
+    /// Rows of all tables waiting to be written to file
+    struct RowBuffer {
+      std::vector<run_info_t>      runs;
+      std::vector<sns_data_t>      sns_data;
+      std::vector<hit_info_t>      hits;
+      std::vector<particle_info_t> particles;
+      std::vector<sns_pos_t>       sns_pos;
+      std::vector<step_info_t>     steps;
+      std::vector<trj_point_t>     trj_points;
+      std::vector<string_dict_t>   strings;
+      std::vector<particle_code_t> particle_codes;
+      std::vector<step_code_t>     step_codes;
+      std::vector<light_point_t>   light_points;
+      std::vector<light_prob_t>    light_probs;
+      std::vector<light_profile_t> light_profiles;
+    };
+
+    /// return the code of a string, adding it to the dictionary if new
+    int32_t Intern(const char*);
+
+    void CreateStepTable();
+    void CreateTrajectoryPointTable();
+    void CreateLightTables();
+
+    /// write to file all the rows of the buffer
+    void WriteBuffer(RowBuffer&);
+
+    /// write all the rows of a table buffer in a single operation
+    template <typename T>
+    void WriteRows(const std::vector<T>& rows, size_t table,
+                   size_t memtype, size_t& counter);
+
+    /// flush the buffer if any of its tables has reached the chunk size
+    void CheckBufferSize(size_t nrows);
+
+    /// body of the writer thread
+    void WriterLoop();
+    /// write the pending batches and stop the writer thread
+    void StopWriterThread();
 
   private:
     size_t file_; ///< HDF5 file
@@ -57,6 +131,11 @@ namespace nexus {
     size_t particleInfoTable_;
     size_t snsPosTable_;
     size_t stepTable_;
+    size_t trjPointTable_;
+    size_t stringDictTable_;
+    size_t lightPointTable_;
+    size_t lightProbTable_;
+    size_t lightProfileTable_;
 
     size_t memtypeRun_;
     size_t memtypeSnsData_;
@@ -64,6 +143,11 @@ namespace nexus {
     size_t memtypeParticleInfo_;
     size_t memtypeSnsPos_;
     size_t memtypeStep_;
+    size_t memtypeTrjPoint_;
+    size_t memtypeStringDict_;
+    size_t memtypeLightPoint_;
+    size_t memtypeLightProb_;
+    size_t memtypeLightProfile_;
 
     size_t irun_; ///< counter for configuration parameters
     size_t ismp_; ///< counter for written waveform samples
@@ -71,6 +155,29 @@ namespace nexus {
     size_t ipart_; ///< counter for particle information
     size_t ipos_; ///< counter for sensor positions
     size_t istep_; ///< counter for steps
+    size_t itrjpoint_; ///< counter for trajectory points
+    size_t istring_; ///< counter for dictionary strings
+    size_t ilightpoint_; ///< counter for light table points
+    size_t ilightprob_; ///< counter for light table probabilities
+    size_t ilightprofile_; ///< counter for light table time profiles
+
+    bool string_dict_; ///< store strings as dictionary codes?
+    std::unordered_map<std::string, int32_t> string_codes_;
+    /// Codes in the file of the strings of this writer, if it is
+    /// appended to another one (indexed by their code in this one)
+    std::vector<int32_t> file_codes_;
+
+    // Rows not yet written to file. They are written when a table
+    // reaches the chunk size of the tables, or when flushed.
+    RowBuffer buffer_;
+
+    bool async_; ///< write the batches in a separate thread?
+    bool stop_;  ///< tell the writer thread to finish
+    std::thread writer_;
+    std::deque<RowBuffer> queue_; ///< batches waiting for the writer thread
+    std::mutex queue_mutex_;
+    std::condition_variable queue_not_empty_;
+    std::condition_variable queue_not_full_;
 
   };
 
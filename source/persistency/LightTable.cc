@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------------
+// nexus | LightTable.cc
+//
+// This class accumulates in memory the light (look-up) table of a job:
+// for every point where photons are generated, the probability of
+// detection of every sensor and, optionally, its time profile.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "LightTable.h"
+
+#include "HDF5Writer.h"
+
+
+namespace nexus {
+
+
+  LightTable::LightTable(): time_profiles_(false)
+  {
+  }
+
+
+
+  LightTable::~LightTable()
+  {
+  }
+
+
+
+  G4int LightTable::AddEvent(const G4ThreeVector& position, G4long nphotons)
+  {
+    // Events generated in the same point (e.g., several events per
+    // point of a grid) are accumulated together
+    std::array<G4double, 3> key = {position.x(), position.y(), position.z()};
+    auto result = index_.emplace(key, points_.size());
+    if (result.second) {
+      Point point;
+      point.position = position;
+      point.nevents  = 0;
+      point.nphotons = 0;
+      points_.push_back(point);
+    }
+
+    Point& point = points_[result.first->second];
+    point.nevents++;
+    point.nphotons += nphotons;
+
+    return result.first->second;
+  }
+
+
+
+  void LightTable::AddCharge(G4int point, G4int sensor_id,
+                             G4long time_bin, G4int charge)
+  {
+    Point& p = points_[point];
+    p.charge[sensor_id] += charge;
+    if (time_profiles_) p.profile[std::make_pair(sensor_id, time_bin)] += charge;
+  }
+
+
+
+  G4double LightTable::GetProbability(G4int point, G4int sensor_id) const
+  {
+    const Point& p = points_[point];
+    auto it = p.charge.find(sensor_id);
+    if (it == p.charge.end() || p.nphotons == 0) return 0.;
+    return it->second / p.nphotons;
+  }
+
+
+
+  void LightTable::Write(HDF5Writer& writer) const
+  {
+    for (size_t i=0; i<points_.size(); i++) {
+      const Point& p = points_[i];
+      writer.WriteLightTablePoint(i, p.position.x(), p.position.y(),
+                                  p.position.z(), p.nevents, p.nphotons);
+      if (p.nphotons == 0) continue;
+
+      for (const auto& sensor: p.charge)
+        writer.WriteLightTableProbability(i, sensor.first,
+                                          sensor.second / p.nphotons);
+
+      for (const auto& bin: p.profile)
+        writer.WriteLightTableProfile(i, bin.first.first, bin.first.second,
+                                      bin.second / p.nphotons);
+    }
+  }
+
+
+} // end namespace nexus
@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------------
+// nexus | LightTable.h
+//
+// This class accumulates in memory the light (look-up) table of a job:
+// for every point where photons are generated, the probability of
+// detection of every sensor and, optionally, its time profile.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef LIGHT_TABLE_H
+#define LIGHT_TABLE_H
+
+#include <G4ThreeVector.hh>
+
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace nexus {
+
+  class HDF5Writer;
+
+  class LightTable
+  {
+  public:
+    /// Constructor
+    LightTable();
+    /// Destructor
+    ~LightTable();
+
+    /// Accumulate also the detected photons per time bin
+    void SetTimeProfiles(G4bool);
+
+    /// Register an event generating a number of photons in a point,
+    /// returning the index of the point in the table
+    G4int AddEvent(const G4ThreeVector& position, G4long nphotons);
+
+    /// Add photons detected by a sensor in a time bin, for a point
+    void AddCharge(G4int point, G4int sensor_id, G4long time_bin, G4int charge);
+
+    /// Return the number of points of the table
+    G4int GetNumberOfPoints() const;
+    /// Return the probability of detection of a sensor for a point
+    G4double GetProbability(G4int point, G4int sensor_id) const;
+
+    /// Write the table (the probabilities normalized to the photons
+    /// generated in every point)
+    void Write(HDF5Writer&) const;
+
+  private:
+    struct Point {
+      G4ThreeVector position;
+      G4int nevents;
+      G4long nphotons;
+      std::map<G4int, G4double> charge; ///< Photons detected per sensor
+      /// Photons detected per sensor and time bin
+      std::map<std::pair<G4int, G4long>, G4double> profile;
+    };
+
+    G4bool time_profiles_;
+    std::vector<Point> points_;
+    std::map<std::array<G4double, 3>, G4int> index_; ///< Points by position
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void LightTable::SetTimeProfiles(G4bool tp)
+  { time_profiles_ = tp; }
+
+  inline G4int LightTable::GetNumberOfPoints() const
+  { return points_.size(); }
+
+} // namespace nexus
+
+#endif
@@ -2,7 +2,8 @@
 // nexus | PersistencyManager.cc
 //
 // This class writes all the relevant information of the simulation
-// to an ouput file.
+// to an ouput file. In multithreaded mode every worker thread has its own
+// instance, which writes the events through the one of the master thread.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -11,24 +12,31 @@
 
 #include "Trajectory.h"
 #include "TrajectoryMap.h"
+#include "TrajectoryPoint.h"
 #include "IonizationSD.h"
 #include "SensorSD.h"
-#include "NexusApp.h"
+#include "SensorRegistry.h"
 #include "DetectorConstruction.h"
 #include "SaveAllSteppingAction.h"
 #include "GeometryBase.h"
 #include "HDF5Writer.h"
+#include "LightTable.h"
 #include "PersistencyManagerBase.h"
 #include "FactoryBase.h"
+#include "EventSeeder.h"
+#include "ScintillationEventInformation.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Event.hh>
+#include <G4PrimaryVertex.hh>
 #include <G4TrajectoryContainer.hh>
 #include <G4Trajectory.hh>
 #include <G4SDManager.hh>
 #include <G4HCtable.hh>
 #include <G4RunManager.hh>
 #include <G4Run.hh>
+#include <G4Threading.hh>
+#include <G4AutoLock.hh>
 
 #include <string>
 #include <sstream>
@@ -41,12 +49,22 @@ using namespace nexus;
 REGISTER_CLASS(PersistencyManager, PersistencyManagerBase)
 
 
+namespace {
+  G4Mutex store_mutex = G4MUTEX_INITIALIZER;
+}
+
+PersistencyManager* PersistencyManager::master_ = 0;
+
+
 PersistencyManager::PersistencyManager():
   PersistencyManagerBase(), msg_(0), ready_(false),
   store_evt_(true), store_steps_(false),
-  interacting_evt_(false), event_type_("other"), saved_evts_(0),
+  interacting_evt_(false), async_(false), store_trj_points_(false),
+  string_dict_(false), light_table_time_profiles_(false),
+  event_type_("other"), saved_evts_(0),
   interacting_evts_(0), pmt_bin_size_(-1), sipm_bin_size_(-1),
-  nevt_(0), start_id_(0), first_evt_(true), h5writer_(0)
+  nevt_(0), evt_id_(0), start_id_(0), first_evt_(true), sns_pos_stored_(false), h5writer_(0),
+  light_table_(0)
 {
   msg_ = new G4GenericMessenger(this, "/nexus/persistency/");
   msg_->DeclareMethod("outputFile", &PersistencyManager::OpenFile, "");
@@ -54,6 +72,50 @@ PersistencyManager::PersistencyManager():
                         "Type of event: bb0nu, bb2nu, background.");
   msg_->DeclareProperty("start_id", start_id_,
                         "Starting event ID for this job.");
+  msg_->DeclareMethod("async", &PersistencyManager::SetAsync,
+                      "Write the output file in a separate thread.");
+  msg_->DeclareMethod("string_dict", &PersistencyManager::SetStringDictionary,
+                      "Store particle names, volumes and processes as codes "
+                      "of the /MC/string_dict table.");
+  msg_->DeclareMethod("trajectory_points", &PersistencyManager::SetTrajectoryPoints,
+                      "Record and store the trajectory points of the particles.");
+  msg_->DeclareMethod("trajectory_points_particle",
+                      &PersistencyManager::AddTrajectoryPointsParticle,
+                      "Record trajectory points only for this particle.");
+  G4GenericMessenger::Command& trj_energy_cmd =
+    msg_->DeclareMethodWithUnit("trajectory_points_min_energy", "MeV",
+                                &PersistencyManager::SetTrajectoryPointsMinEnergy,
+                                "Minimum initial kinetic energy of the particles "
+                                "recording trajectory points.");
+  trj_energy_cmd.SetParameterName("trajectory_points_min_energy", false);
+  trj_energy_cmd.SetRange("trajectory_points_min_energy>=0.");
+
+  // The merging of the ionization hits is common to all the
+  // sensitive detectors, so it is only set in the master thread
+  msg_->DeclareMethod("hits_merging", &PersistencyManager::SetHitsMerging,
+                      "Merge the ionization hits into voxels.")
+    .SetCandidates("none track event")
+    .SetToBeBroadcasted(false);
+  msg_->DeclareMethodWithUnit("hits_voxel_size", "mm",
+                              &PersistencyManager::SetHitsVoxelSize,
+                              "Size of the voxels the ionization hits are merged into.")
+    .SetToBeBroadcasted(false);
+  msg_->DeclareMethodWithUnit("hits_time_window", "ns",
+                              &PersistencyManager::SetHitsTimeWindow,
+                              "Time window of the voxels the ionization hits are "
+                              "merged into (1 us by default).")
+    .SetToBeBroadcasted(false);
+
+  // The light table is accumulated by the instance of the master thread
+  msg_->DeclareMethod("light_table", &PersistencyManager::SetLightTable,
+                      "Accumulate the light table of the job instead of "
+                      "storing the events.")
+    .SetToBeBroadcasted(false);
+  msg_->DeclareProperty("light_table_time_profiles", light_table_time_profiles_,
+                        "Store also the time profiles of the light table.")
+    .SetToBeBroadcasted(false);
+
+  if (G4Threading::IsMasterThread()) master_ = this;
 
   init_macro_ = "";
   macros_.clear();
@@ -65,8 +127,10 @@ PersistencyManager::PersistencyManager():
 
 PersistencyManager::~PersistencyManager()
 {
+  if (master_ == this) master_ = 0;
   delete msg_;
   delete h5writer_;
+  delete light_table_;
 }
 
 
@@ -92,11 +156,20 @@ PersistencyManager::~PersistencyManager()
 
 void PersistencyManager::OpenFile(G4String filename)
 {
+  // The output file is owned by the instance of the master thread
+  if (master_ != this) return;
+
   // If the output file was not set yet, do so
   if (!h5writer_) {
     h5writer_ = new HDF5Writer();
+    h5writer_->SetStringDictionary(string_dict_);
     G4String hdf5file = filename + ".h5";
     h5writer_->Open(hdf5file, store_steps_);
+    output_file_ = hdf5file;
+    h5writer_->SetAsync(async_);
+    // The file is usually opened before the geometry is constructed,
+    // in which case the sensor positions are written with the first event
+    StoreSensorPositions();
     return;
   } else {
     G4Exception("[PersistencyManager]", "OpenFile()",
@@ -106,10 +179,92 @@ void PersistencyManager::OpenFile(G4String filename)
 
 
 
+void PersistencyManager::SetAsync(G4bool async)
+{
+  async_ = async;
+  if (h5writer_) h5writer_->SetAsync(async_);
+}
+
+
+
+void PersistencyManager::SetStringDictionary(G4bool string_dict)
+{
+  // The format of the tables is fixed once the file is created
+  if (h5writer_ && string_dict != string_dict_) {
+    G4Exception("[PersistencyManager]", "SetStringDictionary()", JustWarning,
+                "The string dictionary must be set before the output file is opened.");
+    return;
+  }
+  string_dict_ = string_dict;
+}
+
+
+
+void PersistencyManager::SetTrajectoryPoints(G4bool store)
+{
+  // The settings of the trajectories are kept per thread,
+  // and every thread has its own instance of this class
+  store_trj_points_ = store;
+  TrajectoryMap::SetPointRecording(store);
+}
+
+
+
+void PersistencyManager::AddTrajectoryPointsParticle(G4String name)
+{
+  TrajectoryMap::AddPointParticle(name);
+}
+
+
+
+void PersistencyManager::SetTrajectoryPointsMinEnergy(G4double energy)
+{
+  TrajectoryMap::SetPointMinEnergy(energy);
+}
+
+
+
+void PersistencyManager::SetHitsMerging(G4String mode)
+{
+  IonizationSD::SetMergeMode(mode);
+}
+
+
+
+void PersistencyManager::SetHitsVoxelSize(G4double size)
+{
+  IonizationSD::SetVoxelSize(size);
+}
+
+
+
+void PersistencyManager::SetHitsTimeWindow(G4double window)
+{
+  IonizationSD::SetTimeWindow(window);
+}
+
+
+
+void PersistencyManager::SetLightTable(G4bool light_table)
+{
+  if (!light_table) {
+    delete light_table_;
+    light_table_ = 0;
+  }
+  else if (!light_table_) {
+    light_table_ = new LightTable();
+  }
+}
+
+
+
 void PersistencyManager::CloseFile()
 {
   if (!h5writer_) return;
 
+  // The light table is written once, with all the events of the job
+  if (light_table_) light_table_->Write(*h5writer_);
+
   h5writer_->Close();
 }
 
@@ -117,25 +272,55 @@ void PersistencyManager::CloseFile()
 
 G4bool PersistencyManager::Store(const G4Event* event)
 {
-  if (interacting_evt_) {
-    interacting_evts_++;
-  }
+  // The event is counted by the instance of the master thread, which
+  // owns the output file. It is converted into rows by the instance of
+  // its own thread, out of the lock, and then handed to the master one.
+  // (In sequential mode, master_ is this.)
+  PersistencyManager* pm = master_;
+
+  {
+    G4AutoLock lock(&store_mutex);
 
-  if (!store_evt_) {
-    TrajectoryMap::Clear();
-    if (store_steps_) {
-      SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
-        G4RunManager::GetRunManager()->GetUserSteppingAction();
-      sa->Reset();
+    if (interacting_evt_) {
+      pm->interacting_evts_++;
     }
-    return false;
-  }
 
-  saved_evts_++;
+    if (!store_evt_) {
+      lock.unlock();
+      ClearEvent();
+      return false;
+    }
+
+    pm->saved_evts_++;
+
+    if (pm->first_evt_) {
+      pm->first_evt_ = false;
+      pm->nevt_ = pm->start_id_;
+    }
+
+    // Events seeded on their own keep their global ID, which
+    // is all that is needed to reproduce them
+    if (EventSeeder::Instance().IsEnabled())
+      pm->nevt_ = pm->start_id_ + event->GetEventID();
+
+    evt_id_ = pm->nevt_++;
+
+    pm->StoreSensorPositions();
 
-  if (first_evt_) {
-    first_evt_ = false;
-    nevt_ = start_id_;
+    // In light-table mode the events are only accumulated in the table
+    if (pm->light_table_) {
+      pm->AccumulateLightTable(event);
+      lock.unlock();
+      ClearEvent();
+      return true;
+    }
+  }
+
+  // The rows of a worker thread are buffered in a writer of its
+  // own, with no file, until they are appended to the master one
+  if (!h5writer_) {
+    h5writer_ = new HDF5Writer();
+    h5writer_->SetStringDictionary(pm->string_dict_);
   }
 
   if (store_steps_)
@@ -147,7 +332,18 @@ G4bool PersistencyManager::Store(const G4Event* event)
   // Store ionization hits and sensor hits
   StoreHits(event->GetHCofThisEvent());
 
-  nevt_++;
+  {
+    G4AutoLock lock(&store_mutex);
+
+    if (pm != this) {
+      pm->h5writer_->Append(*h5writer_);
+      pm->sensdet_bin_.insert(sensdet_bin_.begin(), sensdet_bin_.end());
+    }
+
+    // Write to file the rows of the event in one go (or hand
+    // them to the writer thread, in asynchronous mode)
+    pm->h5writer_->Flush();
+  }
 
   TrajectoryMap::Clear();
   StoreCurrentEvent(true);
@@ -156,6 +352,18 @@ G4bool PersistencyManager::Store(const G4Event* event)
 }
 
 
+
+void PersistencyManager::ClearEvent()
+{
+  TrajectoryMap::Clear();
+  if (store_steps_) {
+    SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
+      G4RunManager::GetRunManager()->GetUserSteppingAction();
+    sa->Reset();
+  }
+}
+
+
 void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
 {
   // If the pointer is null, no trajectories were stored in this event
@@ -176,8 +384,8 @@ void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
     G4ThreeVector final_xyz = trj->GetFinalPosition();
     G4double final_t = trj->GetFinalTime();
 
-    G4String ini_volume = trj->GetInitialVolume();
-    G4String final_volume = trj->GetFinalVolume();
+    const G4String& ini_volume = trj->GetInitialVolume();
+    const G4String& final_volume = trj->GetFinalVolume();
 
     G4double mass = trj->GetParticleDefinition()->GetPDGMass();
     G4ThreeVector ini_mom = trj->GetInitialMomentum();
@@ -192,7 +400,7 @@ void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
     } else {
       mother_id = trj->GetParentID();
     }
-    h5writer_->WriteParticleInfo(nevt_, trackid, trj->GetParticleName().c_str(),
+    h5writer_->WriteParticleInfo(evt_id_, trackid, trj->GetParticleName().c_str(),
 				 primary, mother_id,
 				 (float)ini_xyz.x(), (float)ini_xyz.y(),
                                  (float)ini_xyz.z(), (float)ini_t,
@@ -206,6 +414,24 @@ void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
                                  trj->GetCreatorProcess().c_str(),
 				 trj->GetFinalProcess().c_str());
 
+    if (!store_trj_points_) continue;
+
+    // Every point is stored as its difference with the previous one
+    // (the first, with the initial vertex). The differences are taken
+    // with respect to the stored (single-precision) values, so that
+    // their cumulative sum in single precision gives back the points.
+    float x = ini_xyz.x(), y = ini_xyz.y(), z = ini_xyz.z(), t = ini_t;
+    for (G4int j=0; j<trj->GetPointEntries(); ++j) {
+      TrajectoryPoint* point = (TrajectoryPoint*) trj->GetPoint(j);
+      G4ThreeVector xyz = point->GetPosition();
+      float dx = xyz.x() - x;
+      float dy = xyz.y() - y;
+      float dz = xyz.z() - z;
+      float dt = point->GetTime() - t;
+      h5writer_->WriteTrajectoryPoint(evt_id_, trackid, j, dx, dy, dz, dt);
+      x += dx; y += dy; z += dz; t += dt;
+    }
+
   }
 }
 
@@ -252,7 +478,7 @@ void PersistencyManager::StoreIonizationHits(G4VHitsCollection* hc)
     dynamic_cast<IonizationHitsCollection*>(hc);
   if (!hits) return;
 
-  hit_map_.clear();
+  hit_count_.clear();
 
   double evt_energy = 0.;
   std::string sdname = hits->GetSDname();
@@ -264,19 +490,11 @@ void PersistencyManager::StoreIonizationHits(G4VHitsCollection* hc)
 
     G4int trackid = hit->GetTrackID();
 
-    std::vector<G4int>* ihits = nullptr;
-    std::map<G4int, std::vector<G4int>* >::iterator it = hit_map_.find(trackid);
-    if (it != hit_map_.end()) {
-      ihits = it->second;
-    } else {
-       ihits = new std::vector<G4int>;
-      hit_map_[trackid] = ihits;
-    }
-
-    ihits->push_back(1);
+    // Hits are numbered per track
+    G4int hit_id = hit_count_[trackid]++;
 
     G4ThreeVector xyz = hit->GetPosition();
-    h5writer_->WriteHitInfo(nevt_, trackid,  ihits->size() - 1,
+    h5writer_->WriteHitInfo(evt_id_, trackid, hit_id,
 			    xyz[0], xyz[1], xyz[2],
 			    hit->GetTime(), hit->GetEnergyDeposit(),
 			    sdname.c_str());
@@ -292,6 +510,30 @@ void PersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
   SensorHitsCollection* hits = dynamic_cast<SensorHitsCollection*>(hc);
   if (!hits) return;
 
+  StoreSensorBinning(hits);
+
+  for (size_t i=0; i<hits->entries(); i++) {
+
+    SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(i));
+    if (!hit) continue;
+
+    for (SensorHit::const_iterator it = hit->begin(); it != hit->end(); ++it) {
+      unsigned int time_bin = (unsigned int)(*it).first;
+      unsigned int charge = (unsigned int)(*it).second;
+
+      h5writer_->WriteSensorDataInfo(evt_id_, (unsigned int)hit->GetPmtID(),
+                                     time_bin, charge);
+    }
+  }
+}
+
+
+
+void PersistencyManager::StoreSensorBinning(G4VHitsCollection* hc)
+{
+  SensorHitsCollection* hits = dynamic_cast<SensorHitsCollection*>(hc);
+  if (!hits) return;
+
   std::string sdname = hits->GetSDname();
 
   std::map<G4String, G4double>::const_iterator sensdet_it = sensdet_bin_.find(sdname);
@@ -304,40 +546,70 @@ void PersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
       break;
     }
   }
+}
 
-  for (size_t i=0; i<hits->entries(); i++) {
 
-    SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(i));
-    if (!hit) continue;
 
-    G4ThreeVector xyz = hit->GetPosition();
-    G4double binsize = hit->GetBinSize();
+void PersistencyManager::AccumulateLightTable(const G4Event* event)
+{
+  const G4PrimaryVertex* vertex = event->GetPrimaryVertex();
+  if (!vertex) return;
+
+  // The photons of an event are generated in a single point. In
+  // streaming mode most of them are not primary particles, and only
+  // the generator knows how many there are.
+  G4long nphotons = 0;
+  const ScintillationEventInformation* info =
+    dynamic_cast<const ScintillationEventInformation*>(event->GetUserInformation());
+  if (info) {
+    nphotons = info->GetNumberOfPhotons();
+  }
+  else {
+    for (const G4PrimaryVertex* v = vertex; v; v = v->GetNext())
+      nphotons += v->GetNumberOfParticle();
+  }
+
+  light_table_->SetTimeProfiles(light_table_time_profiles_);
+  G4int point = light_table_->AddEvent(vertex->GetPosition(), nphotons);
 
-    const std::map<G4double, G4int>& wvfm = hit->GetHistogram();
-    std::map<G4double, G4int>::const_iterator it;
-    std::vector< std::pair<unsigned int,float> > data;
-    G4double amplitude = 0.;
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if (!hce) return;
 
-    for (it = wvfm.begin(); it != wvfm.end(); ++it) {
-      unsigned int time_bin = (unsigned int)((*it).first/binsize+0.5);
-      unsigned int charge = (unsigned int)((*it).second+0.5);
+  for (G4int i=0; i<hce->GetNumberOfCollections(); i++) {
+    SensorHitsCollection* hits =
+      dynamic_cast<SensorHitsCollection*>(hce->GetHC(i));
+    if (!hits) continue;
 
-      data.push_back(std::make_pair(time_bin, charge));
-      amplitude = amplitude + (*it).second;
+    StoreSensorBinning(hits);
 
-      h5writer_->WriteSensorDataInfo(nevt_, (unsigned int)hit->GetPmtID(),
-                                     time_bin, charge);
-    }
+    for (size_t j=0; j<hits->entries(); j++) {
+      SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(j));
+      if (!hit) continue;
 
-    std::vector<G4int>::iterator pos_it =
-      std::find(sns_posvec_.begin(), sns_posvec_.end(), hit->GetPmtID());
-    if (pos_it == sns_posvec_.end()) {
-      h5writer_->WriteSensorPosInfo((unsigned int)hit->GetPmtID(), sdname.c_str(),
-				    (float)xyz.x(), (float)xyz.y(), (float)xyz.z());
-      sns_posvec_.push_back(hit->GetPmtID());
+      for (SensorHit::const_iterator it = hit->begin(); it != hit->end(); ++it)
+        light_table_->AddCharge(point, hit->GetPmtID(), (*it).first, (*it).second);
     }
+  }
+}
 
+
+
+void PersistencyManager::StoreSensorPositions()
+{
+  // The positions of all the sensors of the geometry are written
+  // once, as soon as both the file and the geometry are ready
+  const SensorRegistry& registry = SensorRegistry::Instance();
+  if (sns_pos_stored_ || !h5writer_ || !registry.IsBuilt()) return;
+
+  for (G4int i=0; i<registry.GetNumberOfSensors(); i++) {
+    const SensorRegistry::SensorInfo& sensor = registry.GetSensor(i);
+    h5writer_->WriteSensorPosInfo((unsigned int)sensor.id, sensor.name.c_str(),
+                                  (float)sensor.position.x(),
+                                  (float)sensor.position.y(),
+                                  (float)sensor.position.z());
   }
+
+  sns_pos_stored_ = true;
 }
 
 
@@ -346,43 +618,42 @@ void PersistencyManager::StoreSteps()
   SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
     G4RunManager::GetRunManager()->GetUserSteppingAction();
 
-  StepContainer<G4String> initial_volumes = sa->get_initial_volumes();
-  StepContainer<G4String>   final_volumes = sa->get_final_volumes  ();
-  StepContainer<G4String>      proc_names = sa->get_proc_names     ();
-
-  StepContainer<G4ThreeVector> initial_poss = sa->get_initial_poss();
-  StepContainer<G4ThreeVector>   final_poss = sa->get_final_poss  ();
-
-  for (auto it = initial_volumes.begin(); it != initial_volumes.end(); ++it) {
-    std::pair<G4int, G4String> key           = it->first;
-    G4int                      track_id      = key.first;
-    G4String                   particle_name = key.second;
-
-    for (size_t step_id=0; step_id < it->second.size(); ++step_id) {
-      h5writer_->WriteStep(nevt_, track_id, particle_name, step_id,
-                           initial_volumes[key][step_id],
-                             final_volumes[key][step_id],
-                                proc_names[key][step_id],
-                           initial_poss   [key][step_id].x(),
-                           initial_poss   [key][step_id].y(),
-                           initial_poss   [key][step_id].z(),
-                             final_poss   [key][step_id].x(),
-                             final_poss   [key][step_id].y(),
-                             final_poss   [key][step_id].z());
-    }
+  // The steps are read in place, in the order they were taken
+  const SaveAllSteppingAction::StepBuffer& steps = sa->GetSteps();
+
+  for (size_t i=0; i<steps.size(); ++i) {
+    h5writer_->WriteStep(evt_id_, steps.track_id[i],
+                         sa->GetName(steps.particle[i]).c_str(),
+                         steps.step_id[i],
+                         sa->GetName(steps.initial_volume[i]).c_str(),
+                         sa->GetName(steps.  final_volume[i]).c_str(),
+                         sa->GetName(steps.process       [i]).c_str(),
+                         steps.initial_pos[i].x(),
+                         steps.initial_pos[i].y(),
+                         steps.initial_pos[i].z(),
+                         steps.  final_pos[i].x(),
+                         steps.  final_pos[i].y(),
+                         steps.  final_pos[i].z());
   }
   sa->Reset();
 }
 
 G4bool PersistencyManager::Store(const G4Run*)
 {
+  // The run information is written once, by the master thread,
+  // after all the worker threads are done
+  if (master_ != this) return false;
+
+  // In case no event was stored
+  StoreSensorPositions();
+
   // Store the event type
   G4String key = "event_type";
   h5writer_->WriteRunInfo(key, event_type_.c_str());
 
   // Store the number of events to be processed
-  NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
-  G4int num_events = app->GetNumberOfEventsToBeProcessed();
+  G4int num_events =
+    G4RunManager::GetRunManager()->GetNumberOfEventsToBeProcessed();
 
   key = "num_events";
   h5writer_->WriteRunInfo(key,  std::to_string(num_events).c_str());
@@ -391,6 +662,13 @@ G4bool PersistencyManager::Store(const G4Run*)
   key = "interacting_events";
   h5writer_->WriteRunInfo(key,  std::to_string(interacting_evts_).c_str());
 
+  // Store the seed actually used (the system time for negative seeds)
+  const EventSeeder& seeder = EventSeeder::Instance();
+  key = "random_seed";
+  h5writer_->WriteRunInfo(key,  std::to_string(seeder.GetRunSeed()).c_str());
+  key = "event_seeding";
+  h5writer_->WriteRunInfo(key,  seeder.IsEnabled() ? "true" : "false");
+
   std::map<G4String, G4double>::const_iterator it;
   for (it = sensdet_bin_.begin(); it != sensdet_bin_.end(); ++it) {
     h5writer_->WriteRunInfo((it->first + "_binning").c_str(),
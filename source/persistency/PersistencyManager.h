@@ -2,7 +2,8 @@
 // nexus | PersistencyManager.h
 //
 // This class writes all the relevant information of the simulation
-// to an ouput file.
+// to an ouput file. In multithreaded mode every worker thread has its own
+// instance, which writes the events through the one of the master thread.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -14,6 +15,7 @@
 
 #include <G4VPersistencyManager.hh>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 
@@ -25,6 +27,7 @@ class G4VHitsCollection;
 namespace nexus {
   class HDF5Writer;
   class IonizationHit;
+  class LightTable;
 }
 
 namespace nexus {
@@ -58,6 +61,39 @@ namespace nexus {
     void OpenFile(G4String);
     void CloseFile();
 
+    G4int GetStartID() const;
+    G4String GetOutputFile() const;
+
+    /// Write the output file in a separate thread, so that the
+    /// simulation of the next event overlaps with it
+    void SetAsync(G4bool);
+
+    /// Store the strings of the particle and step tables as codes
+    /// defined in the /MC/string_dict table
+    void SetStringDictionary(G4bool);
+
+    /// Record the trajectory points of the particles and store
+    /// them in the output file
+    void SetTrajectoryPoints(G4bool);
+    /// Record trajectory points only for the given particle
+    /// (it can be invoked several times)
+    void AddTrajectoryPointsParticle(G4String);
+    /// Record trajectory points only for particles created
+    /// with at least this kinetic energy
+    void SetTrajectoryPointsMinEnergy(G4double);
+
+    /// Merge the ionization hits into voxels: "none", "track" or "event"
+    void SetHitsMerging(G4String);
+    /// Set the size of the voxels the ionization hits are merged into
+    void SetHitsVoxelSize(G4double);
+    /// Set the time window of the voxels the ionization hits are merged into
+    void SetHitsTimeWindow(G4double);
+
+    /// Accumulate the light table of the job (the probability of
+    /// detection of every sensor for every point where photons are
+    /// generated) instead of storing the events
+    void SetLightTable(G4bool);
+
 
   private:
     void StoreTrajectories(G4TrajectoryContainer*);
@@ -65,11 +101,17 @@ namespace nexus {
     void StoreIonizationHits(G4VHitsCollection*);
     void StoreSensorHits(G4VHitsCollection*);
     void StoreSteps();
+    void StoreSensorPositions();
+    void StoreSensorBinning(G4VHitsCollection*);
+    void AccumulateLightTable(const G4Event*);
+    void ClearEvent();
 
     void SaveConfigurationInfo(G4String history);
 
 
   private:
+    static PersistencyManager* master_; ///< Instance owning the output file
+
     G4GenericMessenger* msg_; ///< User configuration messenger
 
    // G4String init_macro_;
@@ -81,6 +123,10 @@ namespace nexus {
     G4bool store_evt_; ///< Should we store the current event?
     G4bool store_steps_; ///< Should we store the steps for the current event?
     G4bool interacting_evt_; ///< Has the current event interacted in ACTIVE?
+    G4bool async_; ///< Is the output file written by a separate thread?
+    G4bool store_trj_points_; ///< Should we store the trajectory points?
+    G4bool string_dict_; ///< Are strings stored as dictionary codes?
+    G4bool light_table_time_profiles_; ///< Light tables with time profiles?
 
     G4String event_type_; ///< event type: bb0nu, bb2nu, background or not set
 
@@ -89,13 +135,16 @@ namespace nexus {
     G4double pmt_bin_size_, sipm_bin_size_; ///< bin width of sensors
 
     G4int nevt_; ///< Event ID
+    G4int evt_id_; ///< ID of the event being stored by this instance
     G4int start_id_; ///< ID for the first event in file
     G4bool first_evt_; ///< true only for the first event of the run
+    G4bool sns_pos_stored_; ///< Have the sensor positions been written?
 
     HDF5Writer* h5writer_;  ///< Event writer to hdf5 file
+    G4String output_file_;  ///< Name of the hdf5 file
+    LightTable* light_table_; ///< Light table of the job (if in that mode)
 
-    std::map<G4int, std::vector<G4int>* > hit_map_;
-    std::vector<G4int> sns_posvec_;
+    std::unordered_map<G4int, G4int> hit_count_; ///< Hits stored per track
 
     std::map<G4String, G4double> sensdet_bin_;
   };
@@ -109,6 +158,10 @@ namespace nexus {
   { store_steps_ = ss; }
   inline void PersistencyManager::InteractingEvent(G4bool ie)
   { interacting_evt_ = ie; }
+  inline G4int PersistencyManager::GetStartID() const
+  { return start_id_; }
+  inline G4String PersistencyManager::GetOutputFile() const
+  { return master_ ? master_->output_file_ : output_file_; }
   inline G4bool PersistencyManager::Store(const G4VPhysicalVolume*)
   { return false; }
   inline G4bool PersistencyManager::Retrieve(G4Event*&)
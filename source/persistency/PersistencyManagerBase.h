@@ -13,6 +13,13 @@ class PersistencyManagerBase: public G4VPersistencyManager
 
      virtual void CloseFile() = 0;
 
+     /// ID of the first event of the job (the global ID of an
+     /// event is this plus its Geant4 event ID)
+     virtual G4int GetStartID() const { return 0; }
+
+     /// Name of the output file (empty if none was opened)
+     virtual G4String GetOutputFile() const { return ""; }
+
      G4String init_macro_;
      std::vector<G4String> macros_;
      std::vector<G4String> delayed_macros_;
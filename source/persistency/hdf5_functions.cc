@@ -134,6 +134,118 @@ hsize_t createStepType()
   return memtype;
 }
 
+hsize_t createTrajectoryPointType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(trj_point_t));
+  H5Tinsert (memtype, "event_id"   , HOFFSET(trj_point_t, event_id   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_id", HOFFSET(trj_point_t, particle_id), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "point_id"   , HOFFSET(trj_point_t, point_id   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "dx"         , HOFFSET(trj_point_t, dx         ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "dy"         , HOFFSET(trj_point_t, dy         ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "dz"         , HOFFSET(trj_point_t, dz         ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "dt"         , HOFFSET(trj_point_t, dt         ), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
+hsize_t createStringDictType()
+{
+  hid_t strtype = H5Tcopy(H5T_C_S1);
+  H5Tset_size (strtype, STRLEN);
+
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(string_dict_t));
+  H5Tinsert (memtype, "code" , HOFFSET(string_dict_t, code ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "value", HOFFSET(string_dict_t, value), strtype);
+  return memtype;
+}
+
+hsize_t createParticleCodeType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (particle_code_t));
+  H5Tinsert (memtype, "event_id", HOFFSET (particle_code_t, event_id), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_id", HOFFSET (particle_code_t, particle_id), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_name", HOFFSET (particle_code_t, particle_name), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "primary", HOFFSET (particle_code_t, primary), H5T_NATIVE_CHAR);
+  H5Tinsert (memtype, "mother_id", HOFFSET (particle_code_t, mother_id), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "initial_x", HOFFSET (particle_code_t, initial_x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_y", HOFFSET (particle_code_t, initial_y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_z", HOFFSET (particle_code_t, initial_z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_t", HOFFSET (particle_code_t, initial_t), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_x", HOFFSET (particle_code_t, final_x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_y", HOFFSET (particle_code_t, final_y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_z", HOFFSET (particle_code_t, final_z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_t", HOFFSET (particle_code_t, final_t), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_volume", HOFFSET (particle_code_t, initial_volume), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "final_volume", HOFFSET (particle_code_t, final_volume), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "initial_momentum_x", HOFFSET (particle_code_t, initial_momentum_x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_momentum_y", HOFFSET (particle_code_t, initial_momentum_y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_momentum_z", HOFFSET (particle_code_t, initial_momentum_z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_momentum_x", HOFFSET (particle_code_t, final_momentum_x), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_momentum_y", HOFFSET (particle_code_t, final_momentum_y), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_momentum_z", HOFFSET (particle_code_t, final_momentum_z), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "kin_energy", HOFFSET (particle_code_t, kin_energy), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "length", HOFFSET (particle_code_t, length), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "creator_proc", HOFFSET (particle_code_t, creator_proc), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "final_proc", HOFFSET (particle_code_t, final_proc), H5T_NATIVE_INT32);
+  return memtype;
+}
+
+hsize_t createStepCodeType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(step_code_t));
+  H5Tinsert (memtype, "event_id"      , HOFFSET(step_code_t, event_id      ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_id"   , HOFFSET(step_code_t, particle_id   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "particle_name" , HOFFSET(step_code_t, particle_name ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "step_id"       , HOFFSET(step_code_t, step_id       ), H5T_NATIVE_INT  );
+  H5Tinsert (memtype, "initial_volume", HOFFSET(step_code_t, initial_volume), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "final_volume"  , HOFFSET(step_code_t, final_volume  ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "proc_name"     , HOFFSET(step_code_t, proc_name     ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "initial_x"     , HOFFSET(step_code_t, initial_x     ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_y"     , HOFFSET(step_code_t, initial_y     ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "initial_z"     , HOFFSET(step_code_t, initial_z     ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_x"       , HOFFSET(step_code_t, final_x       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_y"       , HOFFSET(step_code_t, final_y       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "final_z"       , HOFFSET(step_code_t, final_z       ), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
+hsize_t createLightPointType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(light_point_t));
+  H5Tinsert (memtype, "point_id", HOFFSET(light_point_t, point_id), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "x"       , HOFFSET(light_point_t, x       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "y"       , HOFFSET(light_point_t, y       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "z"       , HOFFSET(light_point_t, z       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "nevents" , HOFFSET(light_point_t, nevents ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "nphotons", HOFFSET(light_point_t, nphotons), H5T_NATIVE_INT64);
+  return memtype;
+}
+
+hsize_t createLightProbabilityType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(light_prob_t));
+  H5Tinsert (memtype, "point_id"   , HOFFSET(light_prob_t, point_id   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "sensor_id"  , HOFFSET(light_prob_t, sensor_id  ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "probability", HOFFSET(light_prob_t, probability), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
+hsize_t createLightProfileType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(light_profile_t));
+  H5Tinsert (memtype, "point_id"   , HOFFSET(light_profile_t, point_id   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "sensor_id"  , HOFFSET(light_profile_t, sensor_id  ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "time_bin"   , HOFFSET(light_profile_t, time_bin   ), H5T_NATIVE_INT32);
+  H5Tinsert (memtype, "probability", HOFFSET(light_profile_t, probability), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
 hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype)
 {
   //Create 1D dataspace (evt number). First dimension is unlimited (initially 0)
@@ -146,16 +258,30 @@ hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype)
   // The layout of the dataset have to be chunked when using unlimited dimensions
   hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
   H5Pset_layout(plist, H5D_CHUNKED);
-  hsize_t chunk_dims[ndims] = {32768};
+  hsize_t chunk_dims[ndims] = {CHUNKSIZE};
   H5Pset_chunk(plist, ndims, chunk_dims);
 
-  //Set compression
-  //  int clevel = 0;
-  //  H5Pset_deflate (plist, clevel);
+  //Set compression (if the HDF5 library was built with it). The shuffle
+  //filter groups the bytes of the columns, which makes them compress better.
+  if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+    H5Pset_shuffle(plist);
+    H5Pset_deflate(plist, 4);
+  }
+
+  // Keep in memory the chunk being filled, so that every chunk is
+  // compressed only once, when it is complete (the default chunk
+  // cache is smaller than the chunks of the tables with long rows)
+  hid_t access = H5Pcreate(H5P_DATASET_ACCESS);
+  size_t chunk_bytes = CHUNKSIZE * H5Tget_size(memtype);
+  H5Pset_chunk_cache(access, 521, chunk_bytes + 1, 1.);
 
   // Create dataset
   hid_t dataset = H5Dcreate(group, table_name.c_str(), memtype, file_space,
-                            H5P_DEFAULT, plist, H5P_DEFAULT);
+                            H5P_DEFAULT, plist, access);
+
+  H5Pclose(access);
+  H5Pclose(plist);
+  H5Sclose(file_space);
 
   return dataset;
 }
@@ -169,126 +295,26 @@ hid_t createGroup(hid_t file, std::string& groupName)
   return wfgroup;
 }
 
-void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype, hsize_t counter)
+void writeRows(const void* rows, hsize_t nrows, hid_t dataset, hid_t memtype, hsize_t counter)
 {
-  hid_t memspace, file_space;
-  hsize_t dims[1] = {1};
-  memspace = H5Screate_simple(1, dims, NULL);
+  if (nrows == 0) return;
 
-  //Extend dataset
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, runData);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-
-void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype, hsize_t counter)
-{
-  hid_t memspace, file_space;
-  //Create memspace for one more row
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
-
-  //Extend dataset
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  //Write waveforms
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsData);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype, hsize_t counter)
-{
-  hid_t memspace, file_space;
-
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
-
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, hitInfo);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-void writeParticle(particle_info_t* particleInfo, hid_t dataset, hid_t memtype, hsize_t counter)
-{
-  hid_t memspace, file_space;
-
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
-
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, particleInfo);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype, hsize_t counter)
-{
-  hid_t memspace, file_space;
-  //Create memspace for one more row
-  const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
-  memspace = H5Screate_simple(n_dims, dims, NULL);
-
-  //Extend dataset
-  dims[0] = counter+1;
-  H5Dset_extent(dataset, dims);
-
-  //Write waveforms
-  file_space = H5Dget_space(dataset);
-  hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
-  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsPos);
-  H5Sclose(file_space);
-  H5Sclose(memspace);
-}
-
-void writeStep(step_info_t* step, hid_t dataset, hid_t memtype, hsize_t counter)
-{
   hid_t memspace, file_space;
 
+  //Create memspace for the whole batch of rows
   const hsize_t n_dims = 1;
-  hsize_t dims[n_dims] = {1};
+  hsize_t dims[n_dims] = {nrows};
   memspace = H5Screate_simple(n_dims, dims, NULL);
 
-  dims[0] = counter + 1;
+  //Extend dataset once for all the rows
+  dims[0] = counter + nrows;
   H5Dset_extent(dataset, dims);
 
   file_space = H5Dget_space(dataset);
   hsize_t start[1] = {counter};
-  hsize_t count[1] = {1};
+  hsize_t count[1] = {nrows};
   H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
-  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, step);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, rows);
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
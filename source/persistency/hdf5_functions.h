@@ -14,6 +14,7 @@
 
 #define CONFLEN 300
 #define STRLEN 100
+#define CHUNKSIZE 32768
 
   typedef struct{
      char param_key[CONFLEN];
@@ -91,22 +92,116 @@
     float     final_z;
   } step_info_t;
 
+  // With the string dictionary enabled, the particle and step tables
+  // store the codes of their strings, defined in the string_dict table
+  typedef struct{
+    int32_t code;
+    char    value[STRLEN];
+  } string_dict_t;
+
+  typedef struct{
+    int32_t event_id;
+    int32_t particle_id;
+    int32_t particle_name;
+    char    primary;
+    int32_t mother_id;
+    float   initial_x;
+    float   initial_y;
+    float   initial_z;
+    float   initial_t;
+    float   final_x;
+    float   final_y;
+    float   final_z;
+    float   final_t;
+    int32_t initial_volume;
+    int32_t final_volume;
+    float   initial_momentum_x;
+    float   initial_momentum_y;
+    float   initial_momentum_z;
+    float   final_momentum_x;
+    float   final_momentum_y;
+    float   final_momentum_z;
+    float   kin_energy;
+    float   length;
+    int32_t creator_proc;
+    int32_t final_proc;
+  } particle_code_t;
+
+  typedef struct{
+    int32_t event_id;
+    int32_t particle_id;
+    int32_t particle_name;
+    int     step_id;
+    int32_t initial_volume;
+    int32_t final_volume;
+    int32_t proc_name;
+    float   initial_x;
+    float   initial_y;
+    float   initial_z;
+    float   final_x;
+    float   final_y;
+    float   final_z;
+  } step_code_t;
+
+  // Trajectory points are stored as differences with respect to the
+  // previous point of the particle (or its initial vertex, for the
+  // first one), which compress much better than absolute values
+  typedef struct{
+    int32_t event_id;
+    int32_t particle_id;
+    int32_t point_id;
+    float   dx;
+    float   dy;
+    float   dz;
+    float   dt;
+  } trj_point_t;
+
+  // Light tables: the points of the table, and the probability of
+  // detection of every sensor for every point (only those non-zero)
+  // and, optionally, per time bin of the sensor
+  typedef struct{
+    int32_t point_id;
+    float   x;
+    float   y;
+    float   z;
+    int32_t nevents;
+    int64_t nphotons;
+  } light_point_t;
+
+  typedef struct{
+    int32_t point_id;
+    int32_t sensor_id;
+    float   probability;
+  } light_prob_t;
+
+  typedef struct{
+    int32_t point_id;
+    int32_t sensor_id;
+    int32_t time_bin;
+    float   probability;
+  } light_profile_t;
+
   hsize_t createRunType();
   hsize_t createSensorDataType();
   hsize_t createHitInfoType();
   hsize_t createParticleInfoType();
   hsize_t createSensorPosType();
   hsize_t createStepType();
+  hsize_t createTrajectoryPointType();
+  hsize_t createStringDictType();
+  hsize_t createParticleCodeType();
+  hsize_t createStepCodeType();
+  hsize_t createLightPointType();
+  hsize_t createLightProbabilityType();
+  hsize_t createLightProfileType();
 
+  /// Create a table, compressed with the shuffle and deflate filters
+  /// (if the HDF5 library supports them)
   hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype);
   hid_t createGroup(hid_t file, std::string& groupName);
 
-  void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype, hsize_t counter);
-  void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype, hsize_t counter);
-  void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype, hsize_t counter);
-  void writeParticle(particle_info_t* particleInfo, hid_t dataset, hid_t memtype, hsize_t counter);
-  void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype, hsize_t counter);
-  void writeStep(step_info_t* step, hid_t dataset, hid_t memtype, hsize_t counter);
+  /// Append nrows consecutive rows to the table, extending it once
+  void writeRows(const void* rows, hsize_t nrows, hid_t dataset, hid_t memtype, hsize_t counter);
 
 
 #endif
@@ -34,10 +34,21 @@ namespace nexus {
     /// drifting under the influence of the field. Returns the step length.
     virtual G4double Drift(G4LorentzVector&) = 0;
 
+    /// Drifts a batch of n charge carriers, as Drift() does with every
+    /// one of them, writing their step lengths in the second array.
+    /// Fields may override it with a faster implementation.
+    virtual void Drift(G4LorentzVector* xyzt, G4double* step_lengths, size_t n);
+
     /// Returns a random 4D point (space and time) along a drift line
     virtual G4LorentzVector 
       GeneratePointAlongDriftLine(const G4LorentzVector&, const G4LorentzVector&) = 0;
 
+    /// Fills an array with n random 4D points along a drift line.
+    /// Fields may override it with a faster implementation.
+    virtual void GeneratePointsAlongDriftLine(const G4LorentzVector& origin,
+                                              const G4LorentzVector& end,
+                                              G4LorentzVector* points, size_t n);
+
     virtual G4double LightYield() const;
 
   private:
@@ -52,6 +63,20 @@ namespace nexus {
 
   inline G4double BaseDriftField::LightYield() const {return 0.;}
 
+  inline void BaseDriftField::Drift(G4LorentzVector* xyzt,
+                                    G4double* step_lengths, size_t n)
+  {
+    for (size_t i=0; i<n; i++) step_lengths[i] = Drift(xyzt[i]);
+  }
+
+  inline void BaseDriftField::GeneratePointsAlongDriftLine(
+    const G4LorentzVector& origin, const G4LorentzVector& end,
+    G4LorentzVector* points, size_t n)
+  {
+    for (size_t i=0; i<n; i++)
+      points[i] = GeneratePointAlongDriftLine(origin, end);
+  }
+
   inline void BaseDriftField::Print() const {}
 
 } // end namespace nexus
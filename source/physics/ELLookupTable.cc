@@ -1,7 +1,13 @@
 // ----------------------------------------------------------------------------
 // nexus | ELLookupTable.cc
 //
-// This class describes the generation of the EL light.
+// This class describes the generation of the EL light. It stores, for every
+// point of a regular grid in the EL region, the probability of the light
+// produced there to be detected by each sensor in a few time bins.
+//
+// The table can be read from a text file (lines with point id, sensor id
+// and the probabilities) or, much faster, mapped into memory from a binary
+// file written by WriteBinaryFile(), which records the grid of the table.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -9,201 +15,277 @@
 #include "ELLookupTable.h"
 
 #include <fstream>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+namespace {
+
+  // Header of the binary files, followed by the (npoints+1) offsets
+  // and the nentries sensor responses of the table
+  struct BinaryHeader {
+    char magic[8];
+    int32_t num_time_bins;
+    int32_t npoints;
+    int64_t nentries;
+    double radius; // of the grid, in mm
+    double pitch;  // of the grid, in mm
+  };
+
+  const char binary_magic[8] = "NXELT02";
+
+  G4bool SameLength(G4double a, G4double b)
+  {
+    return std::abs(a - b) <= 1.e-6 * std::max(std::abs(a), std::abs(b));
+  }
+
+}
 
 
 
 namespace nexus {
 
 
-  ELLookupTable::ELLookupTable(G4String filename)
+  ELLookupTable::ELLookupTable(G4String filename, G4double radius, G4double pitch):
+    radius_(radius), pitch_(pitch), nbins_(0), lower_(0.),
+    npoints_(0), offsets_(0), entries_(0), mapping_(0), mapping_size_(0)
   {
-    // read the text files and store their content in the transient table
-    ReadFiles(filename);
+    BuildIndex();
+
+    if (!MapBinaryFile(filename)) ReadTextFile(filename);
+
+    // Every point of the grid must be in the table
+    G4int max_id = 0;
+    for (G4int id: index_) max_id = std::max(max_id, id);
+    if (npoints_ <= max_id) {
+      G4String msg = "The EL table " + filename + " has fewer points than the grid.";
+      G4Exception("[ELLookupTable]", "ELLookupTable()", FatalException, msg);
+    }
   }
 
 
 
   ELLookupTable::~ELLookupTable()
   {
+    if (mapping_) munmap(mapping_, mapping_size_);
   }
 
 
 
-  void ELLookupTable::ReadFiles(G4String filename)
+  void ELLookupTable::BuildIndex()
   {
-    // Open the file containing the light table
-    std::ifstream file(filename, std::ifstream::out);
+    /// The EL points must be in the middle of the bins.
+    nbins_ = radius_*2./pitch_ + 1;
+    lower_ = -pitch_*(nbins_/2.);
+
+    /// If the number of bins per axis is odd, a different math must be applied
+    bool even = (nbins_ % 2 == 0);
 
-    if (!file.is_open())
-      {}
-      //G4Exception("[ELLookupTable] ERROR: cannot open input file!");
+    /// Coordinates of the center of bins (they are the same in
+    /// x and y, because it is a regular squared grid)
+    std::vector<G4double> bincenters;
+    for (G4int i=0; i<nbins_; i++)
+      bincenters.push_back(lower_ + pitch_/2. + i*pitch_);
 
-    // Deal with the header file
-    G4String line;
+    /// For every coordinate in x, a column is built with a number of bins equal
+    /// to the number of EL points which have that x. Only the points
+    /// which fall inside the circle are taken into account,
+    /// so columns have not all the same number of points.
+    std::vector<G4int> columns(nbins_, 0);
+    for (G4int i=0; i<nbins_; i++) {
+      if (!even && (i == 0 || i == nbins_-1)) continue;
+      G4double y = std::sqrt(radius_*radius_ - bincenters[i]*bincenters[i]);
+      ///If the y coord of the circle falls further than the center of the bin,
+      ///that bin is included, otherwise it isn't.
+      if (even) {
+        if ((y/pitch_) - std::floor(y/pitch_) < 0.5)
+          columns[i] = std::floor(y/pitch_)*2.;
+        else
+          columns[i] = std::ceil(y/pitch_)*2.;
+      } else {
+        G4double r = (y-pitch_/2.)/pitch_;
+        if (r - std::floor(r) < 0.5)
+          columns[i] = std::floor(r)*2.+1;
+        else if (y < radius_)
+          columns[i] = std::ceil(r)*2.+1;
+        else
+          columns[i] = std::ceil(r)*2.-1;
+      }
+    }
 
-    do {
-      getline(file, line);
-    } while(line[0] == '*');
+    /// Points are numbered column by column, from the bottom up
+    std::vector<G4int> first_id(nbins_, 0);
+    for (G4int i=1; i<nbins_; i++)
+      first_id[i] = first_id[i-1] + columns[i-1];
 
-    // Read file and store content in the transient table
+    index_.assign(nbins_*nbins_, -1);
+    for (G4int i=0; i<nbins_; i++) {
+      G4int base = (nbins_ - columns[i])/2;
+      for (G4int j=base; j<base+columns[i]; j++)
+        index_[i*nbins_ + j] = first_id[i] + j - base;
+    }
 
-    int num_bins = 5;
-    int last_point_id = 0;
-    std::map<int, std::vector<double> > sensor_map;
+    /// Bins not corresponding to any EL point get the closest one
+    std::vector<G4int> valid_index(index_);
+    for (G4int i=0; i<nbins_; i++) {
+      for (G4int j=0; j<nbins_; j++) {
+        if (valid_index[i*nbins_ + j] >= 0) continue;
+        G4double min_dist2 = 1.E12;
+        for (G4int k=0; k<nbins_; k++) {
+          for (G4int l=0; l<nbins_; l++) {
+            G4int id = valid_index[k*nbins_ + l];
+            if (id < 0) continue;
+            G4double dx = bincenters[i] - bincenters[k];
+            G4double dy = bincenters[j] - bincenters[l];
+            if (dx*dx + dy*dy < min_dist2) {
+              min_dist2 = dx*dx + dy*dy;
+              index_[i*nbins_ + j] = id;
+            }
+          }
+        }
+      }
+    }
+  }
 
-    while (!file.eof()) {
 
-      G4int point_id, sensor_id;
-      std::vector<double> probs;
 
-      file >> point_id >> sensor_id;
+  G4int ELLookupTable::GetPointID(const G4ThreeVector& hitpos) const
+  {
+    G4int binX = std::floor((hitpos.x() - lower_)/pitch_);
+    G4int binY = std::floor((hitpos.y() - lower_)/pitch_);
+    binX = std::min(std::max(binX, 0), nbins_-1);
+    binY = std::min(std::max(binY, 0), nbins_-1);
+    return index_[binX*nbins_ + binY];
+  }
 
-      for (G4int i=0; i<num_bins; i++) {
-	G4double prob;
-	file >> prob;
-	probs.push_back(prob);
-      }
 
-      sensor_map.insert(std::make_pair(sensor_id, probs));
 
-      if (point_id != last_point_id) {
-	ELtable_.push_back(sensor_map);
+  void ELLookupTable::ReadTextFile(G4String filename)
+  {
+    // Open the file containing the light table
+    std::ifstream file(filename);
+
+    if (!file.is_open()) {
+      G4String msg = "Cannot open the EL table " + filename;
+      G4Exception("[ELLookupTable]", "ReadTextFile()", FatalException, msg);
+    }
+
+    // Skip the header lines
+    G4String line;
+    std::streampos start = file.tellg();
+    while (getline(file, line) && line[0] == '*')
+      start = file.tellg();
+    file.seekg(start);
+
+    // Read file and store content in the table. The entries must
+    // be sorted by point id.
+    offsets_storage_.assign(1, 0);
+
+    G4int point_id, sensor_id;
+    while (file >> point_id >> sensor_id) {
+
+      SensorResponse entry;
+      entry.sensor_id = sensor_id;
+      for (G4int i=0; i<num_time_bins; i++) file >> entry.probs[i];
+
+      if (point_id < (G4int) offsets_storage_.size() - 2) {
+        G4String msg = "The EL table " + filename + " is not sorted by point id.";
+        G4Exception("[ELLookupTable]", "ReadTextFile()", FatalException, msg);
       }
 
-      last_point_id = point_id;
+      // Close the range of the previous points
+      while ((G4int) offsets_storage_.size() < point_id + 2)
+        offsets_storage_.push_back(entries_storage_.size());
+
+      entries_storage_.push_back(entry);
+      offsets_storage_.back() = entries_storage_.size();
     }
+
+    npoints_ = offsets_storage_.size() - 1;
+    offsets_ = offsets_storage_.data();
+    entries_ = entries_storage_.data();
   }
 
 
 
-  const std::map<int, std::vector<double> >&
-  ELLookupTable::GetSensorsMap(const G4ThreeVector& hitpos)
+  G4bool ELLookupTable::MapBinaryFile(G4String filename)
   {
-    /// The EL points must be in the middle of the bins.
-    double radius = 92.5; // mm
-    double binning = 5.; // mm
-    int maxidx = radius*2./binning + 1;
-    /// If the number of bins per axis is odd, a different math must be applied
-    bool even = false;
-    if ((maxidx/2.-floor(maxidx/2.)) == 0.){
-      even = true;
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    BinaryHeader header;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(header) ||
+        read(fd, &header, sizeof(header)) != (ssize_t) sizeof(header) ||
+        std::memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0) {
+      // Not a binary table
+      close(fd);
+      return false;
     }
-    std::vector<double> bincenters;
-    std::vector<int> content;
-    /// Fill a vector with the coordinates of the center of bins (they are the same in
-    /// x and y, because it is a regular squared grid)
-    for (int i=0; i<maxidx; i++){
-      double bincenter = -binning*(maxidx/2.) + binning/2.+ i*binning;
-      bincenters.push_back(bincenter);
-    }
-    /// For every coordinate in x, a column is built with a number of bins equal
-    /// to the number of EL points which have that x. Remember that only the points
-    /// which falls inside a circle of a fixed radius are taken into account,
-    /// so columns have not all the same number of points
-
-    /// Content of elements for every column in the grid
-    std::vector<int> columns;
-    if (even){
-      for (int i=0; i<maxidx; i++){
-	double y = sqrt(radius*radius - bincenters[i]*bincenters[i]);
-	double col = 0;
-	///If the y coord of the circle falls further than the center of the bin,
-	///that bin is included, otherwise it isn't.
-	if ((y/binning) - floor(y/binning)<0.5){
-	  col = floor(y/binning)*2.;
-	} else {
-	  col = ceil(y/binning)*2.;
-	}
-	columns.push_back(col);
-      }
-    } else {
-      columns.push_back(0);
-      for (int i=1; i<maxidx-1; i++){
-	double y = sqrt(radius*radius - bincenters[i]*bincenters[i]);
-	double col = 0;
-	///If the y coord of the circle falls further than the center of the bin,
-	///that bin is included, otherwise it isn't.
-	if ((y-binning/2.)/binning - floor((y-binning/2.)/binning)<0.5){
-	  col = floor((y-binning/2.)/binning)*2.+1;
-	} else {
-	  if (y < radius){
-	    col = ceil((y-binning/2.)/binning)*2.+1;
-	  } else {
-	    col = ceil((y-binning/2.)/binning)*2.-1;
-	  }
-	}
-	columns.push_back(col);
-      }
-      columns.push_back(0);
+
+    size_t size = sizeof(header) + (header.npoints+1) * sizeof(int64_t)
+      + header.nentries * sizeof(SensorResponse);
+
+    if (header.num_time_bins != num_time_bins || (size_t) st.st_size != size) {
+      close(fd);
+      G4String msg = "The binary EL table " + filename + " is corrupted.";
+      G4Exception("[ELLookupTable]", "MapBinaryFile()", FatalException, msg);
     }
 
-    for (unsigned int i=0; i<columns.size(); i++){
-      content.push_back(columns[i]);
+    // The point ids depend on the grid
+    if (!SameLength(header.radius, radius_) || !SameLength(header.pitch, pitch_)) {
+      close(fd);
+      G4String msg = "The binary EL table " + filename + " was made for a grid"
+        " of radius " + std::to_string(header.radius) + " mm and pitch " +
+        std::to_string(header.pitch) + " mm, not " + std::to_string(radius_) +
+        " mm and " + std::to_string(pitch_) + " mm.";
+      G4Exception("[ELLookupTable]", "MapBinaryFile()", FatalException, msg);
     }
 
-    int id;
+    mapping_ = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
 
-    /// Maths to obtain the right ID number of the points
-    int zero = maxidx/2;
-    int binX = zero + ceil(hitpos[0]/5.);
-    int binY = zero + ceil(hitpos[1]/5.);
-    if (!even) {
-      zero = floor(maxidx/2)+1;
-      if (hitpos[0]/binning-floor(hitpos[0]/binning) >= 0.5){
-	binX = zero + ceil(hitpos[0]/binning);
-      } else {
-	binX = zero + floor(hitpos[0]/binning);
-      }
-      if (hitpos[1]/binning-floor(hitpos[1]/binning) >= 0.5){
-	binY = zero + ceil(hitpos[1]/binning);
-      } else {
-	binY = zero + floor(hitpos[1]/binning);
-      }
-    }
-    // "binX-1" is due to the fact that content is a vector (starting from 0),
-    // while binX and binY starts from 1
-
-    // number of empty bins starting from below
-    int base = (maxidx - content[binX-1])/2;
-
-    // Check if the point is in a bin which does not correspond to any
-    // EL point. In this case the closest bin is chosen.
-    if (binY > base + content[binX-1] || binY < base+1){
-      double centerX = bincenters[binX-1];
-      double centerY = bincenters[binY-1];
-      double min_dist = 1.E6;
-      int min_xbin = 100;
-      int min_ybin = 100;
-      for (int i=0; i<maxidx; i++){
-	double x = bincenters[i];
-	for (int j=0; j<maxidx; j++){
-	  double y = bincenters[j];
-	  int bx = zero + ceil(x/5.);
-	  int by = zero + ceil(y/5.);
-	  int ped = (maxidx - content[bx-1])/2;;
-	  if (!(by > ped + content[bx-1] || by < ped+1)){
-	    double dist = sqrt(pow(centerX-x,2)+pow(centerY-y,2));
-	    if (dist < min_dist){
-	      min_dist = dist;
-	      min_xbin = bx;
-	      min_ybin = by;
-	    }
-	  }
-	}
-      }
-      binX = min_xbin;
-      binY = min_ybin;
-      base = (maxidx - content[binX-1])/2;
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = 0;
+      G4String msg = "Cannot map into memory the EL table " + filename;
+      G4Exception("[ELLookupTable]", "MapBinaryFile()", FatalException, msg);
     }
 
-    int sum = 0;
-    for (int i=0; i<binX-1; i++){
-      sum = sum + content[i];
+    mapping_size_ = size;
+    npoints_ = header.npoints;
+    offsets_ = (const int64_t*) ((const char*) mapping_ + sizeof(header));
+    entries_ = (const SensorResponse*) (offsets_ + npoints_ + 1);
+
+    return true;
+  }
+
+
+
+  void ELLookupTable::WriteBinaryFile(G4String filename) const
+  {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+      G4String msg = "Cannot open for writing " + filename;
+      G4Exception("[ELLookupTable]", "WriteBinaryFile()", FatalException, msg);
     }
-    // The "-1" comes because the EL point IDs start from 0
-    id = sum + binY - base - 1;
 
-    return ELtable_[id];
+    BinaryHeader header;
+    std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.num_time_bins = num_time_bins;
+    header.npoints = npoints_;
+    header.nentries = offsets_[npoints_];
+    header.radius = radius_;
+    header.pitch = pitch_;
+
+    file.write((const char*) &header, sizeof(header));
+    file.write((const char*) offsets_, (npoints_+1) * sizeof(int64_t));
+    file.write((const char*) entries_, header.nentries * sizeof(SensorResponse));
   }
 
 
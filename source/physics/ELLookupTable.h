@@ -1,7 +1,13 @@
 // ----------------------------------------------------------------------------
 // nexus | ELLookupTable.h
 //
-// This class describes the generation of the EL light.
+// This class describes the generation of the EL light. It stores, for every
+// point of a regular grid in the EL region, the probability of the light
+// produced there to be detected by each sensor in a few time bins.
+//
+// The table can be read from a text file (lines with point id, sensor id
+// and the probabilities) or, much faster, mapped into memory from a binary
+// file written by WriteBinaryFile(), which records the grid of the table.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -14,7 +20,7 @@
 #include <globals.hh>
 
 #include <vector>
-#include <map>
+#include <cstdint>
 
 
 namespace nexus {
@@ -22,25 +28,85 @@ namespace nexus {
   class ELLookupTable: public G4VUserRegionInformation
   {
   public:
-    /// Constructor
-    ELLookupTable(G4String);
+    /// Number of time bins of the probabilities of every sensor
+    static const G4int num_time_bins = 5;
+
+    /// Detection probabilities of a sensor for an EL point
+    struct SensorResponse {
+      int32_t sensor_id;
+      float probs[num_time_bins];
+    };
+
+  public:
+    /// Constructor providing the table file (text or binary) and
+    /// the layout of the EL points: a square grid of the given pitch,
+    /// restricted to a circle of the given radius
+    ELLookupTable(G4String filename, G4double radius=92.5, G4double pitch=5.);
     /// Destructor
     ~ELLookupTable();
 
-    /// Read input files and store their content in the transient table
-    void ReadFiles(G4String);
+    /// Returns the id of the EL point for a position in the EL gap.
+    /// Positions not covered by any point get the closest one.
+    G4int GetPointID(const G4ThreeVector&) const;
+
+    /// Returns the number of sensors seeing the light of an EL point
+    G4int GetNumberOfSensors(G4int point_id) const;
+    /// Returns the responses of the sensors seeing an EL point
+    const SensorResponse* GetSensors(G4int point_id) const;
+
+    /// Returns the total number of EL points
+    G4int GetNumberOfPoints() const;
+
+    /// Writes the table in binary format, to be mapped into memory
+    /// when read back. The radius and pitch of the grid are stored
+    /// too, and checked against those of the reader.
+    void WriteBinaryFile(G4String filename) const;
 
-    /// Returns the appropiate sensor map for a given point in the EL gap
-    virtual const std::map<int, std::vector<double> >&
-    GetSensorsMap(const G4ThreeVector&);
+  private:
+    /// Compute the point id of every bin of the grid
+    void BuildIndex();
 
+    /// Read a table in text format
+    void ReadTextFile(G4String filename);
+    /// Map into memory a table in binary format
+    G4bool MapBinaryFile(G4String filename);
 
   private:
+    G4double radius_; ///< Radius of the circle covered by EL points
+    G4double pitch_;  ///< Distance between EL points
+    G4int nbins_;     ///< Number of grid bins per axis
+    G4double lower_;  ///< Lower edge of the grid (same for x and y)
+
+    /// Point id for every bin of the grid ([ix * nbins_ + iy])
+    std::vector<G4int> index_;
 
-    std::vector<std::map<int, std::vector<double> > > ELtable_;
+    // Sensor responses in compressed sparse row format: the
+    // responses of point i are entries_[offsets_[i]:offsets_[i+1]]
+    G4int npoints_;
+    const int64_t* offsets_;
+    const SensorResponse* entries_;
 
+    // Storage of the table, when read from a text file
+    std::vector<int64_t> offsets_storage_;
+    std::vector<SensorResponse> entries_storage_;
+
+    // Mapping of the table, when read from a binary file
+    void* mapping_;
+    size_t mapping_size_;
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4int ELLookupTable::GetNumberOfPoints() const
+  { return npoints_; }
+
+  inline G4int ELLookupTable::GetNumberOfSensors(G4int point_id) const
+  { return offsets_[point_id+1] - offsets_[point_id]; }
+
+  inline const ELLookupTable::SensorResponse*
+  ELLookupTable::GetSensors(G4int point_id) const
+  { return entries_ + offsets_[point_id]; }
+
 } // end namespace nexus
 
 #endif
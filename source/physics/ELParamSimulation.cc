@@ -1,7 +1,11 @@
 // ----------------------------------------------------------------------------
 // nexus | ELParamSimulation.cc
 //
-// This class (WIP) implements a parametrized simulation .
+// This class implements a parametrized simulation of the EL light.
+// Ionization electrons entering the EL region are killed and, instead of
+// generating and tracking the optical photons, the charge detected by every
+// sensor is sampled from a look-up table and registered directly in the
+// sensor hits.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -10,29 +14,31 @@
 
 #include "ELLookupTable.h"
 #include "IonizationElectron.h"
+#include "BaseDriftField.h"
+#include "SensorSD.h"
+#include "SensorRegistry.h"
 
-#include <G4RunManager.hh>
+#include <G4FastStep.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Poisson.hh>
+#include <Randomize.hh>
 
-#include <TRandom2.h>
-#include <TVector3.h>
+#include <cmath>
 
 
 
 namespace nexus {
 
 
-  ELParamSimulation::ELParamSimulation(G4Region* region):
+  ELParamSimulation::ELParamSimulation(G4Region* region,
+                                       const ELLookupTable* table):
     G4VFastSimulationModel("ELParamSimulation", region),
-    table_(0)
+    table_(table), sensors_found_(false)
   {
-    // check whether the region has an EL look-up table attached
-    table_ = dynamic_cast<ELLookupTable*>(region->GetUserInformation());
-    // if (!table_) {
-    //   G4String msg = "ERROR: no EL lookup table attached to the region!";
-    //   G4Exception("[ELParamSimulation]", "ELParamSimulation()",
-    // 		  FatalException, msg);
-    // }
-
+    if (!table_) {
+      G4Exception("[ELParamSimulation]", "ELParamSimulation()",
+                  FatalException, "No EL look-up table provided.");
+    }
   }
 
 
@@ -57,43 +63,89 @@ namespace nexus {
 
 
 
-  void ELParamSimulation::DoIt(const G4FastTrack& ftrack, G4FastStep& /*fstep*/)
+  void ELParamSimulation::DoIt(const G4FastTrack& ftrack, G4FastStep& fstep)
   {
-    // Get spatial coordinates
-    G4ThreeVector position = ftrack.GetPrimaryTrack()->GetPosition();
-
-    G4cout << "position = " << position << G4endl;
-
-
-    //table_->GetSensorsMap()
-
-    //if (HCE_.size() == 0) {
-
-      G4HCofThisEvent* hce =
-	G4RunManager::GetRunManager()->GetCurrentEvent()->GetHCofThisEvent();
-
-      //}
-
-
-    G4cout << "No of collections: " << hce->GetNumberOfCollections() << G4endl;
-
-
-    G4cout << "here" << G4endl;
-
-
-    ///FIXME. Parameters to be put in some other place
-    // G4int fNum_tbins = 5;
-    // G4double fBinWidth = 200.;
-    // G4int gain = 1170;
-
-    // Get track coordinates
-    // ...
+    // The electron does not go any further in any case
+    fstep.KillPrimaryTrack();
+    fstep.SetPrimaryTrackPathLength(0.);
+
+    // The sensors are looked for the first time the model is invoked,
+    // once the sensitive detectors of the thread are set
+    if (!sensors_found_) FindSensors();
+
+    const G4Track* track = ftrack.GetPrimaryTrack();
+
+    // Get the drift field of the region. If none is
+    // defined, no light is produced
+    BaseDriftField* field =
+      dynamic_cast<BaseDriftField*>(ftrack.GetEnvelope()->GetUserInformation());
+    if (!field || field->LightYield() <= 0.) return;
+
+    // Drift the electron across the EL region
+    G4ThreeVector position = track->GetPosition();
+    G4double time = track->GetGlobalTime();
+    G4LorentzVector xyzt(position, time);
+    G4double length = field->Drift(xyzt);
+
+    // Generate a random number of photons around the mean
+    // (as done in the Electroluminescence process). Tracks merged
+    // by the bulk drift carry several electrons (weight).
+    G4double mean = field->LightYield() * length * track->GetWeight();
+    G4int num_photons;
+    if (mean < 10.) { // Poissonian regime
+      num_photons = G4int(G4Poisson(mean));
+    }
+    else {            // Gaussian regime
+      num_photons = G4int(G4RandGauss::shoot(mean, std::sqrt(mean)) + 0.5);
+    }
+    if (num_photons <= 0) return;
+
+    // The time bins of the table split the transit
+    // of the electron across the EL region
+    const G4double time_bin = (xyzt.t() - time) / ELLookupTable::num_time_bins;
+
+    // Sample the charge detected by every sensor seeing the EL point
+    G4int point_id = table_->GetPointID(position);
+    G4int nsensors = table_->GetNumberOfSensors(point_id);
+    const ELLookupTable::SensorResponse* responses = table_->GetSensors(point_id);
+
+    const SensorRegistry& registry = SensorRegistry::Instance();
+
+    for (G4int i=0; i<nsensors; i++) {
+
+      G4int index = registry.GetIndex(responses[i].sensor_id);
+      if (index < 0 || !sensors_[index].sd) continue;
+      const Sensor& sensor = sensors_[index];
+
+      for (G4int k=0; k<ELLookupTable::num_time_bins; k++) {
+        G4int counts = G4Poisson(num_photons * responses[i].probs[k]);
+        if (counts == 0) continue;
+        sensor.sd->RegisterPhoton(responses[i].sensor_id, sensor.position,
+                                  time + (k + 0.5) * time_bin, counts);
+      }
+    }
+  }
 
-    // Ask table for the right sensor map
-    // ...
 
-    // Fill SensorHits according to this map
 
+  void ELParamSimulation::FindSensors()
+  {
+    const SensorRegistry& registry = SensorRegistry::Instance();
+
+    sensors_.resize(registry.GetNumberOfSensors());
+    for (G4int i=0; i<registry.GetNumberOfSensors(); i++) {
+      const SensorRegistry::SensorInfo& info = registry.GetSensor(i);
+      // The sensitive detector of a volume is different in every thread
+      sensors_[i].sd = dynamic_cast<SensorSD*>(info.volume->GetSensitiveDetector());
+      sensors_[i].position = info.position;
+    }
+
+    if (sensors_.empty()) {
+      G4Exception("[ELParamSimulation]", "FindSensors()", JustWarning,
+                  "No sensors found in the geometry.");
+    }
+
+    sensors_found_ = true;
   }
 
 
@@ -1,7 +1,11 @@
 // ----------------------------------------------------------------------------
 // nexus | ELParamSimulation.h
 //
-// This class (WIP) implements a parametrized simulation .
+// This class implements a parametrized simulation of the EL light.
+// Ionization electrons entering the EL region are killed and, instead of
+// generating and tracking the optical photons, the charge detected by every
+// sensor is sampled from a look-up table and registered directly in the
+// sensor hits.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -10,58 +14,53 @@
 #define EL_PARAM_SIMULATION_H
 
 #include <G4VFastSimulationModel.hh>
-#include "SensorHit.h"
+#include <G4ThreeVector.hh>
+
 #include <vector>
 
 
 namespace nexus {
 
   class ELLookupTable;
+  class SensorSD;
 
   class ELParamSimulation: public G4VFastSimulationModel
   {
   public:
-    /// Constructor
-    ELParamSimulation(G4Region* region);
+    /// Constructor providing the EL region and the look-up table
+    /// with the response of the sensors (not owned by the model)
+    ELParamSimulation(G4Region* region, const ELLookupTable* table);
     /// Destructor
     ~ELParamSimulation();
 
-    // This model is only valid for ionization electrons
+    /// This model is only valid for ionization electrons
     G4bool IsApplicable(const G4ParticleDefinition&);
 
-    // You have to return "true" when the dynamics conditions to trigger your
-    // parameterisation are fulfilled. The G4FastTrack provides you access to
-    // the current G4Track, gives simple access to envelope related features
-    // (G4LogicalVolume, G4VSolid, G4AffineTransform references between the
-    // global and the envelope local coordinates systems) and simple access to
-    // the position, momentum expressed in the envelope coordinate system.
-    // Using those quantities and the G4VSolid methods, you can for example
-    // easily check how far you are from the envelope boundary.
-    G4bool ModelTrigger(const G4FastTrack &);
-
-    // Your parameterisation properly said. The G4FastTrack reference provides
-    // input informations. The final state of the particles after parameterisation
-    // has to be returned through the G4FastStep reference. This final state is
-    // described has "requests" the tracking will apply after your
-    // parameterisation has been invoked.
-    void DoIt(const G4FastTrack&, G4FastStep&);
-
-    //To load EL table
-    // void ReadELTable(const char* filename,
-    // 		     std::map<int, std::map<int, std::vector<double> > >& eltable);
+    /// The model is triggered as soon as the electron enters the region
+    G4bool ModelTrigger(const G4FastTrack&);
 
+    /// Drifts the electron across the EL region, samples the number of
+    /// photons it emits and fills the hits of the sensors seeing them
+    /// according to the look-up table. The electron is then killed.
+    void DoIt(const G4FastTrack&, G4FastStep&);
 
   private:
-    //BaseELGrid* elgrid_;
-    // std::map<G4int, std::map<G4int, std::vector<G4double> > >  eltable_;
-
-    // bool timebinning_;
-    // int num_tbins_;
+    /// Sensitive detector and position of a sensor
+    struct Sensor {
+      SensorSD* sd;
+      G4ThreeVector position;
+    };
 
-    ELLookupTable* table_;
+    /// Get the sensitive detectors of this thread for all
+    /// the sensors of the SensorRegistry
+    void FindSensors();
 
-    std::vector<SensorHitsCollection*> HCE_;
+  private:
+    const ELLookupTable* table_;
 
+    /// Sensors of the geometry, by index in the SensorRegistry
+    std::vector<Sensor> sensors_;
+    G4bool sensors_found_;
   };
 
 } // end namespace nexus
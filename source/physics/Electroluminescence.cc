@@ -10,13 +10,16 @@
 
 #include "IonizationElectron.h"
 #include "BaseDriftField.h"
+#include "SpectrumSampler.h"
+#include "NexusMaterialCache.h"
 
-#include <G4MaterialPropertiesTable.hh>
 #include <G4ParticleChange.hh>
 #include <G4OpticalPhoton.hh>
 #include <Randomize.hh>
 #include <G4Poisson.hh>
 #include <G4GenericMessenger.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
 
 #include <CLHEP/Units/PhysicalConstants.h>
 
@@ -27,14 +30,12 @@ using namespace CLHEP;
 
 Electroluminescence::Electroluminescence(const G4String& process_name,
 					                               G4ProcessType type):
-  G4VDiscreteProcess(process_name, type), theFastIntegralTable_(0),
+  G4VDiscreteProcess(process_name, type),
   table_generation_(false), photons_per_point_(0)
 {
   ParticleChange_ = new G4ParticleChange();
   pParticleChange = ParticleChange_;
 
-  BuildThePhysicsTable();
-
    /// Messenger
   msg_ = new G4GenericMessenger(this, "/Physics/Electroluminescence/",
 				"Control commands of the Electroluminescence physics process.");
@@ -49,7 +50,7 @@ Electroluminescence::Electroluminescence(const G4String& process_name,
 
 Electroluminescence::~Electroluminescence()
 {
-  delete theFastIntegralTable_;
+  delete msg_;
 }
 
 
@@ -61,31 +62,39 @@ G4bool Electroluminescence::IsApplicable(const G4ParticleDefinition& pdef)
 
 
 
+void Electroluminescence::BuildPhysicsTable(const G4ParticleDefinition&)
+{
+  // Materials and regions may have changed since the last run
+  volumes_.clear();
+}
+
+
+
 G4VParticleChange*
 Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
 {
   // Initialize particle change with current track values
   ParticleChange_->Initialize(track);
 
-  // Get the current region and its associated drift field.
-  // If no drift field is defined, kill the track and leave
-  G4Region* region = track.GetVolume()->GetLogicalVolume()->GetRegion();
-  BaseDriftField* field =
-    dynamic_cast<BaseDriftField*>(region->GetUserInformation());
+  // Get the drift field associated to the current volume (through
+  // its region). If no drift field is defined, kill the track and leave
+  const VolumeInfo& info = GetVolumeInfo(track.GetVolume()->GetLogicalVolume());
+  BaseDriftField* field = info.field;
   if (!field) {
     ParticleChange_->ProposeTrackStatus(fStopAndKill);
     return G4VDiscreteProcess::PostStepDoIt(track, step);
   }
 
   // Get the light yield from the field
-  const G4double yield = field->LightYield();
+  const G4double yield = info.yield;
   G4double step_length = step.GetStepLength();
 
   if (yield <= 0.)
     return G4VDiscreteProcess::PostStepDoIt(track, step);
 
-  // Generate a random number of photons around mean 'yield'
-  G4double mean = yield * step_length;
+  // Generate a random number of photons around mean 'yield'.
+  // Tracks merged by the bulk drift carry several electrons (weight).
+  G4double mean = yield * step_length * track.GetWeight();
 
   G4int num_photons;
 
@@ -117,71 +126,72 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
   G4double time_end = step.GetPostStepPoint()->GetGlobalTime();
   G4LorentzVector final_position(position_end, time_end);
 
-  // Energy is sampled from integral (like it is
-  // done in G4Scintillation)
-  G4Material* mat = step.GetPostStepPoint()->GetTouchable()->GetVolume()->GetLogicalVolume()->GetMaterial();
-  G4MaterialPropertiesTable* mpt = mat->GetMaterialPropertiesTable();
-  const G4MaterialPropertyVector* spectrum = mpt->GetProperty("ELSPECTRUM");
+  // Energy is sampled from the EL spectrum of the material
+  // at the end of the step
+  const SpectrumSampler* spectrum = NexusMaterialCache::Get
+    (GetVolumeInfo(step.GetPostStepPoint()->GetTouchable()->
+                   GetVolume()->GetLogicalVolume()).material).el_spectrum;
 
-  if (!spectrum) return G4VDiscreteProcess::PostStepDoIt(track, step);
+  if (!spectrum || num_photons <= 0)
+    return G4VDiscreteProcess::PostStepDoIt(track, step);
 
-  G4PhysicsOrderedFreeVector* spectrum_integral =
-    (G4PhysicsOrderedFreeVector*)(*theFastIntegralTable_)(mat->GetIndex());
+  // All the random numbers of the photons are generated at once:
+  // two for the direction, one for the polarization and two for the energy
+  const G4int nrnd = 5;
+  random_.resize(nrnd * num_photons);
+  G4Random::getTheEngine()->flatArray(nrnd * num_photons, random_.data());
 
+  points_.resize(num_photons);
+  field->GeneratePointsAlongDriftLine(initial_position, final_position,
+                                      points_.data(), num_photons);
 
-  G4double sc_max = spectrum_integral->GetMaxValue();
+  photons_.Resize(num_photons);
 
+  // Generate a random direction for every photon (EL is supposed
+  // isotropic) and the polarization accordingly: a random combination
+  // of two unit vectors orthogonal to the momentum (the second one
+  // being the cross product of the momentum and the first one)
   for (G4int i=0; i<num_photons; i++) {
-    // Generate a random direction for the photon
-    // (EL is supposed isotropic)
-    G4double cos_theta = 1. - 2.*G4UniformRand();
+    const G4double* rnd = &random_[nrnd*i];
+
+    G4double cos_theta = 1. - 2.*rnd[0];
     G4double sin_theta = sqrt((1.-cos_theta)*(1.+cos_theta));
 
-    G4double phi = twopi * G4UniformRand();
+    G4double phi = twopi * rnd[1];
     G4double sin_phi = sin(phi);
     G4double cos_phi = cos(phi);
 
-    G4double px = sin_theta * cos_phi;
-    G4double py = sin_theta * sin_phi;
-    G4double pz = cos_theta;
+    G4double psi = twopi * rnd[2];
+    G4double sin_psi = sin(psi);
+    G4double cos_psi = cos(psi);
 
-    G4ThreeVector momentum(px, py, pz);
+    photons_.px[i] = sin_theta * cos_phi;
+    photons_.py[i] = sin_theta * sin_phi;
+    photons_.pz[i] = cos_theta;
 
-    // Determine photon polarization accordingly
-    G4double sx = cos_theta * cos_phi;
-    G4double sy = cos_theta * sin_phi;
-    G4double sz = -sin_theta;
-
-    G4ThreeVector polarization(sx, sy, sz);
-    G4ThreeVector perp = momentum.cross(polarization);
+    photons_.sx[i] = cos_psi * cos_theta * cos_phi - sin_psi * sin_phi;
+    photons_.sy[i] = cos_psi * cos_theta * sin_phi + sin_psi * cos_phi;
+    photons_.sz[i] = -cos_psi * sin_theta;
+  }
 
-    phi = twopi * G4UniformRand();
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
+  // Determine the photon energies
+  for (G4int i=0; i<num_photons; i++)
+    photons_.energy[i] = spectrum->Sample(random_[nrnd*i+3], random_[nrnd*i+4]);
 
-    polarization = cos_phi * polarization + sin_phi * perp;
-    polarization = polarization.unit();
+  for (G4int i=0; i<num_photons; i++) {
 
     // Generate a new photon and set properties
     G4DynamicParticle* photon =
-      new G4DynamicParticle(G4OpticalPhoton::Definition(), momentum);
-
-    photon->
-      SetPolarization(polarization.x(), polarization.y(), polarization.z());
+      new G4DynamicParticle(G4OpticalPhoton::Definition(),
+        G4ThreeVector(photons_.px[i], photons_.py[i], photons_.pz[i]));
 
-    // Determine photon energy
-    G4double sc_value = G4UniformRand()*sc_max;
-    G4double sampled_energy = spectrum_integral->GetEnergy(sc_value);
-    photon->SetKineticEnergy(sampled_energy);
-
-    G4LorentzVector xyzt =
-      field->GeneratePointAlongDriftLine(initial_position, final_position);
+    photon->SetPolarization(photons_.sx[i], photons_.sy[i], photons_.sz[i]);
+    photon->SetKineticEnergy(photons_.energy[i]);
 
     // Create the track
-    G4Track* secondary = new G4Track(photon, xyzt.t(), xyzt.v());
+    G4Track* secondary = new G4Track(photon, points_[i].t(), points_[i].v());
     secondary->SetParentID(track.GetTrackID());
     ParticleChange_->AddSecondary(secondary);
-
   }
 
   return G4VDiscreteProcess::PostStepDoIt(track, step);
@@ -189,62 +199,21 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
 
 
 
-void Electroluminescence::BuildThePhysicsTable()
+const Electroluminescence::VolumeInfo&
+Electroluminescence::GetVolumeInfo(G4LogicalVolume* lv)
 {
-  if (theFastIntegralTable_) return;
-
-  const G4MaterialTable* theMaterialTable = G4Material::GetMaterialTable();
-  G4int numOfMaterials = G4Material::GetNumberOfMaterials();
+  std::unordered_map<G4LogicalVolume*, VolumeInfo>::const_iterator it =
+    volumes_.find(lv);
+  if (it != volumes_.end()) return it->second;
 
-  // create new physics table
+  VolumeInfo info;
 
-  if(!theFastIntegralTable_)
-    theFastIntegralTable_ = new G4PhysicsTable(numOfMaterials);
+  info.field = dynamic_cast<BaseDriftField*>(lv->GetRegion()->GetUserInformation());
+  info.yield = info.field ? info.field->LightYield() : 0.;
 
-  for (G4int i=0 ; i<numOfMaterials; i++) {
+  info.material = lv->GetMaterial();
 
-  	G4PhysicsOrderedFreeVector* aPhysicsOrderedFreeVector =
-  	  new G4PhysicsOrderedFreeVector();
-
-  	// Retrieve vector of scintillation wavelength intensity for
-  	// the material from the material's optical properties table.
-
-  	G4Material* material = (*theMaterialTable)[i];
-
-    G4MaterialPropertiesTable* mpt = material->GetMaterialPropertiesTable();
-
-    if (mpt) {
-
-  	  G4MaterialPropertyVector* theFastLightVector =
-  	    mpt->GetProperty("ELSPECTRUM");
-
-  	  if (theFastLightVector) {
-        ComputeCumulativeDistribution(*theFastLightVector, *aPhysicsOrderedFreeVector);
-		  }
-  	}
-
-  	// The scintillation integral(s) for a given material
-  	// will be inserted in the table(s) according to the
-  	// position of the material in the material table.
-
-  	theFastIntegralTable_->insertAt(i,aPhysicsOrderedFreeVector);
-  }
-}
-
-
-
-void Electroluminescence::ComputeCumulativeDistribution(
-  const G4PhysicsOrderedFreeVector& pdf, G4PhysicsOrderedFreeVector& cdf)
-{
-  G4double sum = 0.;
-  cdf.InsertValues(pdf.Energy(0), sum);
-
-  for (unsigned int i=1; i<pdf.GetVectorLength(); ++i) {
-    G4double area =
-      0.5 * (pdf.Energy(i) - pdf.Energy(i-1)) * (pdf[i] + pdf[i-1]);
-    sum = sum + area;
-    cdf.InsertValues(pdf.Energy(i), sum);
-  }
+  return volumes_[lv] = info;
 }
 
 
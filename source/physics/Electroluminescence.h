@@ -10,14 +10,21 @@
 #define ELECTROLUMINESCENCE_H
 
 #include <G4VDiscreteProcess.hh>
-#include <G4PhysicsOrderedFreeVector.hh>
+#include <G4LorentzVector.hh>
+
+#include <unordered_map>
+#include <vector>
 
 class G4ParticleChange;
 class G4GenericMessenger;
+class G4LogicalVolume;
+class G4Material;
 
 
 namespace nexus {
 
+  class BaseDriftField;
+
   class Electroluminescence: public G4VDiscreteProcess
   {
   public:
@@ -30,6 +37,10 @@ namespace nexus {
     /// Returns true if particle is an ionization electron
     G4bool IsApplicable(const G4ParticleDefinition&);
 
+    /// Forgets the information of the volumes visited so far
+    /// (invoked by Geant4 at the beginning of every run)
+    void BuildPhysicsTable(const G4ParticleDefinition&);
+
   public:
     /// This is the method that implements the EL light emission
     /// as a post-step process, that is, photons are generated as
@@ -37,20 +48,42 @@ namespace nexus {
     G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
 
   private:
+    /// Everything the process needs to know about a volume. The EL
+    /// spectrum is not kept, but looked up in the NexusMaterialCache,
+    /// which is rebuilt (with new samplers) with the geometry.
+    struct VolumeInfo {
+      BaseDriftField* field;     ///< Drift field of its region
+      G4double yield;            ///< Light yield of the field
+      const G4Material* material; ///< Material of the volume
+    };
+
+    /// Photons generated in a step, in structure-of-arrays layout
+    struct PhotonBatch {
+      std::vector<G4double> px, py, pz; ///< Momentum direction
+      std::vector<G4double> sx, sy, sz; ///< Polarization
+      std::vector<G4double> energy;
+
+      void Resize(size_t n);
+    };
 
     /// Returns infinity; i.e., the process does not limit the step,
     /// but sets the 'StronglyForced' condition for the DoIt to be
     /// invoked at every step.
     G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*);
 
-    void BuildThePhysicsTable();
-    void ComputeCumulativeDistribution(const G4PhysicsOrderedFreeVector&,
-                                       G4PhysicsOrderedFreeVector&);
+    /// Returns the (cached) information of a volume
+    const VolumeInfo& GetVolumeInfo(G4LogicalVolume*);
 
   private:
     G4ParticleChange* ParticleChange_;
 
-    G4PhysicsTable* theFastIntegralTable_;
+    /// Information of the volumes visited so far
+    std::unordered_map<G4LogicalVolume*, VolumeInfo> volumes_;
+
+    // Work arrays of the photons generated in a step
+    std::vector<G4double> random_;
+    std::vector<G4LorentzVector> points_;
+    PhotonBatch photons_;
 
     G4GenericMessenger* msg_;
 
@@ -58,6 +91,15 @@ namespace nexus {
     G4int photons_per_point_;
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void Electroluminescence::PhotonBatch::Resize(size_t n)
+  {
+    px.resize(n); py.resize(n); pz.resize(n);
+    sx.resize(n); sy.resize(n); sz.resize(n);
+    energy.resize(n);
+  }
+
 } // end namespace nexus
 
 #endif
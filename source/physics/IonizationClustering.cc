@@ -2,6 +2,8 @@
 // nexus | IonizationClustering.cc
 //
 // This class creates ionization electrons where energy is deposited.
+// In bulk drift mode, the electrons of every step are drifted all at once
+// to the end of the drift region, and only those reaching it are tracked.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -10,6 +12,7 @@
 
 #include "BaseDriftField.h"
 #include "IonizationElectron.h"
+#include "NexusMaterialCache.h"
 #include "SegmentPointSampler.h"
 
 #include <G4ParticleDefinition.hh>
@@ -18,6 +21,11 @@
 #include <Randomize.hh>
 #include <G4LorentzVector.hh>
 #include <G4Gamma.hh>
+#include <G4Material.hh>
+
+#include <array>
+#include <algorithm>
+#include <cmath>
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
@@ -29,7 +37,8 @@ namespace nexus {
 
   IonizationClustering::IonizationClustering(const G4String& process_name,
                                              G4ProcessType type):
-    G4VRestDiscreteProcess(process_name, type), ParticleChange_(0), rnd_(0)
+    G4VRestDiscreteProcess(process_name, type), ParticleChange_(0), rnd_(0),
+    bulk_drift_(false), bulk_length_bin_(0.), bulk_time_bin_(0.)
   {
     // Create particle change object
     ParticleChange_ = new G4ParticleChange();
@@ -131,12 +140,6 @@ namespace nexus {
       num_charges = G4int(G4Poisson(mean));
     }
 
-    ParticleChange_->SetNumberOfSecondaries(num_charges);
-
-    // Track secondaries first
-    if ((track.GetTrackStatus() == fAlive) && num_charges > 0)
-      ParticleChange_->ProposeTrackStatus(fSuspend);
-
     //////////////////////////////////////////////////////////////////
 
     G4ThreeVector momentum_direction(0.,0.,1.);
@@ -149,6 +152,58 @@ namespace nexus {
                   			       step.GetPostStepPoint()->GetGlobalTime());
     rnd_->SetPoints(pre_point, post_point);
 
+    //////////////////////////////////////////////////////////////////
+    // In bulk drift mode, the electrons are drifted here to the end of
+    // the region, and only those surviving are tracked, starting there.
+    // Electrons arriving close to each other can be merged into a single
+    // track whose weight is the number of electrons. This does not apply
+    // to the EL region (a field with light yield), where the electrons
+    // must be tracked step by step to generate the EL light.
+
+    if (bulk_drift_ && field->LightYield() <= 0.) {
+
+      batch_.Clear();
+      for (G4int i=0; i<num_charges; i++) {
+        if (track.GetDefinition() == G4Gamma::Definition())
+          batch_.Add(post_point);
+        else
+          batch_.Add(rnd_->Shoot());
+      }
+
+      DriftBatch(field, step.GetPreStepPoint()->GetMaterial());
+      MergeBatch();
+
+      ParticleChange_->SetNumberOfSecondaries(merged_.Size());
+
+      // Track secondaries first
+      if ((track.GetTrackStatus() == fAlive) && merged_.Size() > 0)
+        ParticleChange_->ProposeTrackStatus(fSuspend);
+
+      for (size_t i=0; i<merged_.Size(); i++) {
+        G4DynamicParticle* ionielectron =
+          new G4DynamicParticle(IonizationElectron::Definition(),
+            momentum_direction, kinetic_energy);
+
+        // The electrons have left the volume of the step, so the
+        // tracking will locate them in the geometry
+        G4Track* aSecondaryTrack =
+          new G4Track(ionielectron, merged_.t[i],
+                      G4ThreeVector(merged_.x[i], merged_.y[i], merged_.z[i]));
+        aSecondaryTrack->SetWeight(merged_.count[i]);
+
+        ParticleChange_->AddSecondary(aSecondaryTrack);
+      }
+
+      return G4VRestDiscreteProcess::PostStepDoIt(track, step);
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    ParticleChange_->SetNumberOfSecondaries(num_charges);
+
+    // Track secondaries first
+    if ((track.GetTrackStatus() == fAlive) && num_charges > 0)
+      ParticleChange_->ProposeTrackStatus(fSuspend);
 
     for (G4int i=0; i<num_charges; i++) {
 
@@ -177,6 +232,109 @@ namespace nexus {
 
 
 
+  void IonizationClustering::DriftBatch(BaseDriftField* field,
+                                        const G4Material* material)
+  {
+    // Attachment by impurities is simulated as in IonizationDrift
+    const NexusMaterialCache::Entry& properties = NexusMaterialCache::Get(material);
+    G4bool attachment = properties.attachment;
+    G4double attach = properties.attachment_time;
+
+    const size_t n = batch_.Size();
+    drift_points_.resize(n);
+    drift_lengths_.resize(n);
+
+    for (size_t i=0; i<n; i++)
+      drift_points_[i].set(batch_.x[i], batch_.y[i], batch_.z[i], batch_.t[i]);
+
+    field->Drift(drift_points_.data(), drift_lengths_.data(), n);
+
+    for (size_t i=0; i<n; i++) {
+      const G4LorentzVector& xyzt = drift_points_[i];
+
+      // Electrons that do not move are lost, as well as the attached ones
+      if (drift_lengths_[i] <= 0. ||
+          (attachment && xyzt.t() > -attach * std::log(G4UniformRand()))) {
+        batch_.count[i] = 0;
+        continue;
+      }
+
+      batch_.x[i] = xyzt.x();
+      batch_.y[i] = xyzt.y();
+      batch_.z[i] = xyzt.z();
+      batch_.t[i] = xyzt.t();
+    }
+  }
+
+
+
+  void IonizationClustering::MergeBatch()
+  {
+    merged_.Clear();
+
+    // No merging: every surviving electron is kept on its own
+    if (bulk_length_bin_ <= 0. || bulk_time_bin_ <= 0.) {
+      for (size_t i=0; i<batch_.Size(); i++) {
+        if (batch_.count[i] == 0) continue;
+        merged_.Add(G4LorentzVector(batch_.x[i], batch_.y[i], batch_.z[i],
+                                    batch_.t[i]), batch_.count[i]);
+      }
+      return;
+    }
+
+    // Sort the electrons by bin, so that those sharing one are contiguous
+    typedef std::array<G4long, 4> Bin;
+    std::vector<std::pair<Bin, size_t>> bins;
+    bins.reserve(batch_.Size());
+
+    for (size_t i=0; i<batch_.Size(); i++) {
+      if (batch_.count[i] == 0) continue;
+      Bin bin = {{ G4long(std::floor(batch_.x[i] / bulk_length_bin_)),
+                   G4long(std::floor(batch_.y[i] / bulk_length_bin_)),
+                   G4long(std::floor(batch_.z[i] / bulk_length_bin_)),
+                   G4long(std::floor(batch_.t[i] / bulk_time_bin_)) }};
+      bins.push_back(std::make_pair(bin, i));
+    }
+
+    std::sort(bins.begin(), bins.end());
+
+    // Every bin is replaced by the centroid of its electrons
+    for (size_t first=0; first<bins.size(); ) {
+      size_t last = first;
+      G4LorentzVector sum;
+      G4int count = 0;
+      for (; last<bins.size() && bins[last].first == bins[first].first; last++) {
+        size_t i = bins[last].second;
+        sum += batch_.count[i] *
+          G4LorentzVector(batch_.x[i], batch_.y[i], batch_.z[i], batch_.t[i]);
+        count += batch_.count[i];
+      }
+      merged_.Add(sum / count, count);
+      first = last;
+    }
+  }
+
+
+
+  void IonizationClustering::ChargeBatch::Clear()
+  {
+    x.clear(); y.clear(); z.clear(); t.clear();
+    count.clear();
+  }
+
+
+
+  void IonizationClustering::ChargeBatch::Add(const G4LorentzVector& xyzt, G4int n)
+  {
+    x.push_back(xyzt.x());
+    y.push_back(xyzt.y());
+    z.push_back(xyzt.z());
+    t.push_back(xyzt.t());
+    count.push_back(n);
+  }
+
+
+
   G4double IonizationClustering::GetMeanFreePath(const G4Track&,
     G4double, G4ForceCondition* condition)
   {
@@ -2,6 +2,8 @@
 // nexus | IonizationClustering.h
 //
 // This class creates ionization electrons where energy is deposited.
+// In bulk drift mode, the electrons of every step are drifted all at once
+// to the end of the drift region, and only those reaching it are tracked.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -10,11 +12,17 @@
 #define IONIZATION_CLUSTERING_H
 
 #include <G4VRestDiscreteProcess.hh>
+#include <G4LorentzVector.hh>
+
+#include <vector>
+
+class G4Material;
 
 
 namespace nexus {
 
   class SegmentPointSampler;
+  class BaseDriftField;
 
   class IonizationClustering: public G4VRestDiscreteProcess
   {
@@ -43,7 +51,31 @@ namespace nexus {
     /// by particles at rest
     G4VParticleChange* AtRestDoIt(const G4Track&, const G4Step&);
 
+    /// Switch on/off the bulk drift of the ionization electrons (it
+    /// never applies to the EL region, where they are always tracked)
+    void SetBulkDrift(G4bool);
+    /// Set the size of the (spatial and time) bins used to merge
+    /// the electrons at the end of the bulk drift. Electrons falling
+    /// in the same bin are tracked together as a single weighted track.
+    /// A zero size means that the electrons are not merged.
+    void SetBulkDriftBinning(G4double length, G4double time);
+
   private:
+    /// Electrons created in a step, in structure-of-arrays layout
+    struct ChargeBatch {
+      std::vector<G4double> x, y, z, t;
+      std::vector<G4int> count;
+
+      void Clear();
+      void Add(const G4LorentzVector& xyzt, G4int n=1);
+      size_t Size() const;
+    };
+
+    /// Drift the electrons of the batch to the end of the field region,
+    /// removing those lost by attachment
+    void DriftBatch(BaseDriftField*, const G4Material*);
+    /// Merge the electrons of the batch falling in the same bin
+    void MergeBatch();
 
     /// Returns infinity; i. e. the process does not limit the step,
     /// but sets the 'StronglyForced' condition for the PostStepDoIt
@@ -58,8 +90,29 @@ namespace nexus {
   private:
     G4ParticleChange* ParticleChange_;
     SegmentPointSampler* rnd_;
+
+    G4bool bulk_drift_;          ///< Drift the electrons without tracking them
+    G4double bulk_length_bin_;   ///< Spatial size of the merging bins
+    G4double bulk_time_bin_;     ///< Time size of the merging bins
+
+    ChargeBatch batch_;  ///< Electrons of the current step
+    ChargeBatch merged_; ///< Electrons of the current step, once merged
+
+    std::vector<G4LorentzVector> drift_points_; ///< Buffers for the
+    std::vector<G4double> drift_lengths_;       ///< batched drift
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void IonizationClustering::SetBulkDrift(G4bool b)
+  { bulk_drift_ = b; }
+
+  inline void IonizationClustering::SetBulkDriftBinning(G4double l, G4double t)
+  { bulk_length_bin_ = l; bulk_time_bin_ = t; }
+
+  inline size_t IonizationClustering::ChargeBatch::Size() const
+  { return count.size(); }
+
 } // end namespace nexus
 
 #endif
@@ -11,6 +11,7 @@
 
 #include "IonizationElectron.h"
 #include "BaseDriftField.h"
+#include "NexusMaterialCache.h"
 
 #include <G4ParticleChangeForTransport.hh>
 #include <G4RegionStore.hh>
@@ -23,7 +24,7 @@ namespace nexus {
 
 
   IonizationDrift::IonizationDrift(const G4String& name, G4ProcessType type):
-    G4VContinuousDiscreteProcess(name, type)
+    G4VContinuousDiscreteProcess(name, type), region_(0), field_(0)
   {
     ParticleChange_ = new G4ParticleChangeForTransport();
     pParticleChange = ParticleChange_;
@@ -54,9 +55,13 @@ namespace nexus {
     // Get current region
     G4Region* region = track.GetVolume()->GetLogicalVolume()->GetRegion();
     
-    // Get the drift field attached to this region
-    BaseDriftField* field = 
-      dynamic_cast<BaseDriftField*>(region->GetUserInformation());
+    // Get the drift field attached to this region (looked up
+    // only when the region changes)
+    if (region != region_) {
+      region_ = region;
+      field_ = dynamic_cast<BaseDriftField*>(region->GetUserInformation());
+    }
+    BaseDriftField* field = field_;
 
     // If the region has no field, the particle won't move 
     // and therefore the step length is zero.
@@ -82,15 +87,15 @@ namespace nexus {
 
       // Simulate attachment by impurities
       
-      G4MaterialPropertiesTable* mpt = 
-        track.GetMaterial()->GetMaterialPropertiesTable();
+      const NexusMaterialCache::Entry& properties =
+        NexusMaterialCache::Get(track.GetMaterial());
 
-      if (!mpt || !(mpt->ConstPropertyExists("ATTACHMENT"))) { 
+      if (!properties.attachment) {
         G4Exception("[IonizationDrift]", "AlongStepDoIt()", JustWarning,
           "No material properties table found. Assuming no attachment.");
       }
       else {
-        const G4double attach = mpt->GetConstProperty("ATTACHMENT");
+        const G4double attach = properties.attachment_time;
         G4double rnd = -attach * log(G4UniformRand());
         if (xyzt_.t() > rnd) 
           ParticleChange_->ProposeTrackStatus(fStopAndKill);
@@ -15,9 +15,12 @@
 
 class G4Navigator;
 class G4ParticleChangeForTransport;
+class G4Region;
 
 namespace nexus {
 
+  class BaseDriftField;
+
   class IonizationDrift: public G4VContinuousDiscreteProcess
   {
   public:
@@ -48,6 +51,8 @@ namespace nexus {
 
   private:
     G4LorentzVector xyzt_;
+    G4Region* region_;       ///< Region of the last step
+    BaseDriftField* field_;  ///< Drift field of the last region
     G4ParticleChangeForTransport* ParticleChange_;
     G4Navigator* nav_; ///< Pointer to the G4 navigator for tracking
   };
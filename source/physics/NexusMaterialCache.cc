@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// nexus | NexusMaterialCache.cc
+//
+// This class holds, for every material, the properties used by the nexus
+// optical and drift processes, already resolved from its material
+// properties table (and the samplers of its spectra). It is filled once
+// the geometry is constructed, so that the processes find them with a
+// single lookup by material index instead of by property name.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "NexusMaterialCache.h"
+
+#include "SpectrumSampler.h"
+
+#include <G4MaterialPropertiesTable.hh>
+
+
+namespace nexus {
+
+  std::vector<NexusMaterialCache::Entry> NexusMaterialCache::entries_;
+  const NexusMaterialCache::Entry NexusMaterialCache::empty_ =
+    {nullptr, nullptr, 0., false, 0., 0., false, 0., nullptr};
+
+
+  namespace {
+
+    /// Return a sampler of the spectrum, or null if it is not a valid one
+    const SpectrumSampler* MakeSampler(const G4MaterialPropertyVector* spectrum)
+    {
+      if (!spectrum || spectrum->GetVectorLength() < 2) return nullptr;
+
+      G4double integral = 0.;
+      for (size_t i=0; i<spectrum->GetVectorLength(); i++) {
+        if ((*spectrum)[i] < 0.) return nullptr;
+        integral += (*spectrum)[i];
+      }
+      if (integral <= 0.) return nullptr;
+
+      return new SpectrumSampler(*spectrum);
+    }
+
+  }
+
+
+
+  void NexusMaterialCache::Build()
+  {
+    Clear();
+
+    const G4MaterialTable* table = G4Material::GetMaterialTable();
+    entries_.assign(table->size(), empty_);
+
+    for (const G4Material* material: *table) {
+      G4MaterialPropertiesTable* mpt = material->GetMaterialPropertiesTable();
+      if (!mpt) continue;
+
+      Entry& entry = entries_[material->GetIndex()];
+
+      entry.wls_efficiency = mpt->GetProperty("WLSCONVEFFICIENCY");
+      if (entry.wls_efficiency) {
+        entry.wls_spectrum = MakeSampler(mpt->GetProperty("WLSCOMPONENT"));
+        if (mpt->ConstPropertyExists("WLSTIMECONSTANT"))
+          entry.wls_time_constant = mpt->GetConstProperty("WLSTIMECONSTANT");
+      }
+
+      entry.photoelectric =
+        mpt->ConstPropertyExists("WORK_FUNCTION") &&
+        mpt->ConstPropertyExists("OP_PHOTOELECTRIC_PROBABILITY");
+      if (entry.photoelectric) {
+        entry.work_function = mpt->GetConstProperty("WORK_FUNCTION");
+        entry.photoelectric_probability =
+          mpt->GetConstProperty("OP_PHOTOELECTRIC_PROBABILITY");
+      }
+
+      entry.attachment = mpt->ConstPropertyExists("ATTACHMENT");
+      if (entry.attachment)
+        entry.attachment_time = mpt->GetConstProperty("ATTACHMENT");
+
+      entry.el_spectrum = MakeSampler(mpt->GetProperty("ELSPECTRUM"));
+    }
+  }
+
+
+
+  void NexusMaterialCache::Clear()
+  {
+    for (Entry& entry: entries_) {
+      delete entry.wls_spectrum;
+      delete entry.el_spectrum;
+    }
+    entries_.clear();
+  }
+
+
+} // end namespace nexus
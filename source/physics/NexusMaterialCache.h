@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------------
+// nexus | NexusMaterialCache.h
+//
+// This class holds, for every material, the properties used by the nexus
+// optical and drift processes, already resolved from its material
+// properties table (and the samplers of its spectra). It is filled once
+// the geometry is constructed, so that the processes find them with a
+// single lookup by material index instead of by property name.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef NEXUS_MATERIAL_CACHE_H
+#define NEXUS_MATERIAL_CACHE_H
+
+#include <G4MaterialPropertyVector.hh>
+#include <G4Material.hh>
+
+#include <vector>
+
+
+namespace nexus {
+
+  class SpectrumSampler;
+
+  class NexusMaterialCache
+  {
+  public:
+    /// Properties of a material (null or false if not defined)
+    struct Entry {
+      /// Wavelength shifting (WLSCONVEFFICIENCY, WLSCOMPONENT, WLSTIMECONSTANT)
+      G4MaterialPropertyVector* wls_efficiency;
+      const SpectrumSampler* wls_spectrum;
+      G4double wls_time_constant;
+
+      /// Photoelectric effect (WORK_FUNCTION, OP_PHOTOELECTRIC_PROBABILITY)
+      G4bool photoelectric;
+      G4double work_function;
+      G4double photoelectric_probability;
+
+      /// Attachment of the ionization electrons (ATTACHMENT)
+      G4bool attachment;
+      G4double attachment_time;
+
+      /// Electroluminescence (ELSPECTRUM)
+      const SpectrumSampler* el_spectrum;
+    };
+
+    /// Fill the cache with all the materials defined so far
+    /// (it must be invoked from the master thread, before the run)
+    static void Build();
+
+    /// Return the properties of a material. Materials created after
+    /// the cache was built are treated as having none of them.
+    static const Entry& Get(const G4Material*);
+
+  private:
+    static void Clear();
+
+  private:
+    static std::vector<Entry> entries_;
+    static const Entry empty_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline const NexusMaterialCache::Entry&
+  NexusMaterialCache::Get(const G4Material* material)
+  {
+    size_t index = material->GetIndex();
+    return (index < entries_.size()) ? entries_[index] : empty_;
+  }
+
+} // end namespace nexus
+
+#endif
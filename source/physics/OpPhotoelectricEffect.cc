@@ -10,6 +10,7 @@
 #include "OpPhotoelectricEffect.h"
 
 #include "IonizationElectron.h"
+#include "NexusMaterialCache.h"
 
 #include <G4Material.hh>
 #include <G4ParticleDefinition.hh>
@@ -52,18 +53,15 @@ namespace nexus {
     // Initialize particle change with current track values
     particle_change_->Initialize(track);
 
-    const G4Material* material = track.GetMaterial();
+    const NexusMaterialCache::Entry& properties =
+      NexusMaterialCache::Get(track.GetMaterial());
 
-    G4MaterialPropertiesTable* mpt = material->GetMaterialPropertiesTable();
-
-    if (!mpt ||
-        !mpt->ConstPropertyExists("WORK_FUNCTION") ||
-        !mpt->ConstPropertyExists("OP_PHOTOELECTRIC_PROBABILITY"))
+    if (!properties.photoelectric)
       return G4VDiscreteProcess::PostStepDoIt(track, step);
 
     G4double photon_energy = track.GetDynamicParticle()->GetTotalEnergy();
-    G4double work_function = mpt->GetConstProperty("WORK_FUNCTION");
-    G4double probability   = mpt->GetConstProperty("OP_PHOTOELECTRIC_PROBABILITY");
+    G4double work_function = properties.work_function;
+    G4double probability   = properties.photoelectric_probability;
 
     if (!work_function || !probability)
       return G4VDiscreteProcess::PostStepDoIt(track, step);
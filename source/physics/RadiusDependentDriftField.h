@@ -24,8 +24,10 @@ namespace nexus {
     /// Destructor
     ~RadiusDependentDriftField();
 
+    using BaseDriftField::Drift;
     virtual G4double Drift(G4LorentzVector&);
 
+    using BaseDriftField::GeneratePointsAlongDriftLine;
     virtual G4LorentzVector GeneratePointAlongDriftLine(const G4LorentzVector&, const G4LorentzVector&);
 
     //virtual G4double LightYield() const;
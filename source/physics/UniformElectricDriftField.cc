@@ -9,10 +9,12 @@
 
 #include "UniformElectricDriftField.h"
 #include "SegmentPointSampler.h"
+#include "RandomUtils.h"
 
 #include <Randomize.hh>
 
 #include <math.h>
+#include <vector>
 #include "CLHEP/Units/SystemOfUnits.h"
 
 
@@ -27,16 +29,12 @@ namespace nexus {
     axis_(axis), anode_pos_(anode_position), cathode_pos_(cathode_position),
     drift_velocity_(0.), transv_diff_(0.), longit_diff_(0.),  light_yield_(0.)
   {
-    // initialize random generator with dummy values
-    rnd_ = new SegmentPointSampler(G4LorentzVector(0.,0.,0.,-999.),
-                                   G4LorentzVector(0.,0.,0.,-999.));
   }
 
 
 
   UniformElectricDriftField::~UniformElectricDriftField()
   {
-    delete rnd_;
   }
 
 
@@ -57,8 +55,9 @@ namespace nexus {
     G4double drift_time = drift_length / drift_velocity_;
 
     // Calculate longitudinal and transversal deviation due to diffusion
-    G4double transv_sigma = transv_diff_ * sqrt(drift_length);
-    G4double longit_sigma = longit_diff_ * sqrt(drift_length);
+    G4double sqrt_length = sqrt(drift_length);
+    G4double transv_sigma = transv_diff_ * sqrt_length;
+    G4double longit_sigma = longit_diff_ * sqrt_length;
     G4double time_sigma = longit_sigma / drift_velocity_;
 
     G4ThreeVector position;
@@ -89,19 +88,77 @@ namespace nexus {
 
 
 
+  void UniformElectricDriftField::Drift(G4LorentzVector* xyzt,
+                                       G4double* step_lengths, size_t n)
+  {
+    // Three normal numbers per carrier: two for the transverse
+    // coordinates and one for the arrival time
+    std::vector<G4double> normals(3*n);
+    GaussianRandomBatch(RandomKey(), 0, normals.data(), 3*n);
+
+    G4double secmargin = -1. * micrometer;
+    if (anode_pos_ > cathode_pos_) secmargin = -secmargin;
+
+    const G4double max_coord = std::max(anode_pos_, cathode_pos_);
+    const G4double min_coord = std::min(anode_pos_, cathode_pos_);
+
+    const G4int axis1 = (axis_ + 1) % 3;
+    const G4int axis2 = (axis_ + 2) % 3;
+
+    for (size_t i=0; i<n; i++) {
+      G4LorentzVector& point = xyzt[i];
+      const G4double coord = point[axis_];
+
+      // Carriers outside the field region don't move
+      if (coord > max_coord || coord < min_coord) {
+        step_lengths[i] = 0.;
+        continue;
+      }
+
+      const G4double drift_length = fabs(coord - anode_pos_);
+      const G4double drift_time = drift_length / drift_velocity_;
+      const G4double sqrt_length = sqrt(drift_length);
+
+      const G4double dx1 = transv_diff_ * sqrt_length * normals[3*i];
+      const G4double dx2 = transv_diff_ * sqrt_length * normals[3*i+1];
+      const G4double dt = longit_diff_ * sqrt_length / drift_velocity_ * normals[3*i+2];
+      const G4double dz = anode_pos_ + secmargin - coord;
+
+      G4double time = point.t() + drift_time + dt;
+      if (time < 0.) time = point.t() + drift_time;
+
+      point[axis1] += dx1;
+      point[axis2] += dx2;
+      point[axis_] = anode_pos_ + secmargin;
+      point.setT(time);
+
+      step_lengths[i] = sqrt(dx1*dx1 + dx2*dx2 + dz*dz);
+    }
+  }
+
+
+
   G4LorentzVector UniformElectricDriftField::GeneratePointAlongDriftLine(
 									 const G4LorentzVector& origin, const G4LorentzVector& end)
   {
+    // The field is shared by all threads, so the sampler
+    // cannot be a member that is modified here
+    SegmentPointSampler rnd(origin, end);
+    return rnd.Shoot();
+  }
 
-    // if (origin != rnd_->GetPrePoint()) {
-      // G4LorentzVector end(origin);
-      // Drift(end);
 
-    rnd_->SetPoints(origin, end);
-    //   }
 
+  void UniformElectricDriftField::GeneratePointsAlongDriftLine(
+    const G4LorentzVector& origin, const G4LorentzVector& end,
+    G4LorentzVector* points, size_t n)
+  {
+    std::vector<G4double> u(n);
+    G4Random::getTheEngine()->flatArray(n, u.data());
 
-    return rnd_->Shoot();
+    const G4LorentzVector delta = end - origin;
+    for (size_t i=0; i<n; i++)
+      points[i] = origin + u[i] * delta;
   }
 
 
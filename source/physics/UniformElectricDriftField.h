@@ -18,8 +18,6 @@ class G4Material;
 
 namespace nexus {
 
-  class SegmentPointSampler;
-
   class UniformElectricDriftField: public BaseDriftField
   {
   public:
@@ -36,8 +34,20 @@ namespace nexus {
     /// of an ionization electron
     G4double Drift(G4LorentzVector& xyzt);
 
+    /// Drift a batch of ionization electrons. The diffusion is sampled
+    /// for all of them at once with a counter-based generator, whose
+    /// key is drawn from the Geant4 engine (hence the results are
+    /// reproducible for a given seed).
+    void Drift(G4LorentzVector* xyzt, G4double* step_lengths, size_t n);
+
     G4LorentzVector GeneratePointAlongDriftLine(const G4LorentzVector&, const G4LorentzVector&);
 
+    /// Generate n points along the drift line (uniformly distributed
+    /// along the segment between origin and end)
+    void GeneratePointsAlongDriftLine(const G4LorentzVector& origin,
+                                      const G4LorentzVector& end,
+                                      G4LorentzVector* points, size_t n);
+
     // Setters/getters
 
     void SetAnodePosition(G4double);
@@ -83,9 +93,6 @@ namespace nexus {
     G4double attachment_;
     G4double light_yield_;
     G4double num_ph_;
-
-    SegmentPointSampler* rnd_;
-
   };
 
 
@@ -13,7 +13,6 @@
 #define WLS_H
 
 #include <G4VDiscreteProcess.hh>
-#include <G4PhysicsOrderedFreeVector.hh>
 
 class G4ParticleChange;
 class G4VWLSTimeGeneratorProfile;
@@ -32,13 +31,8 @@ namespace nexus {
     G4VParticleChange* PostStepDoIt(const G4Track& aTrack, const G4Step& aStep);
     G4double GetMeanFreePath(const G4Track& track, G4double, G4ForceCondition*);
 
-  private:
-    void BuildThePhysicsTable();
-    void ComputeCumulativeDistribution(const G4MaterialPropertyVector& pdf, G4PhysicsOrderedFreeVector& cdf);
-
   private:
     G4ParticleChange* ParticleChange_;
-    G4PhysicsTable* wlsIntegralTable_;
     G4VWLSTimeGeneratorProfile*  WLSTimeGeneratorProfile_;
 
   };
@@ -14,6 +14,8 @@
 #include "Electroluminescence.h"
 #include "WavelengthShifting.h"
 #include "OpPhotoelectricEffect.h"
+#include "ELLookupTable.h"
+#include "ELParamSimulation.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4OpticalPhoton.hh>
@@ -22,6 +24,9 @@
 #include <G4StepLimiter.hh>
 #include <G4FastSimulationManagerProcess.hh>
 #include <G4PhysicsConstructorFactory.hh>
+#include <G4RegionStore.hh>
+#include <G4AutoLock.hh>
+#include <G4SystemOfUnits.hh>
 
 
 namespace nexus {
@@ -34,7 +39,11 @@ namespace nexus {
 
   NexusPhysics::NexusPhysics():
     G4VPhysicsConstructor("NexusPhysics"),
-    clustering_(true), drift_(true), electroluminescence_(true), photoelectric_(false)
+    clustering_(true), drift_(true), electroluminescence_(true), photoelectric_(false),
+    bulk_drift_(false), bulk_length_bin_(0.), bulk_time_bin_(0.),
+    el_table_name_(""), el_region_name_("EL_REGION"),
+    el_table_radius_(92.5*mm), el_table_pitch_(5.*mm), el_table_(0),
+    el_table_mutex_(G4MUTEX_INITIALIZER)
   {
     msg_ = new G4GenericMessenger(this, "/PhysicsList/Nexus/",
       "Control commands of the nexus physics list.");
@@ -51,6 +60,27 @@ namespace nexus {
     msg_->DeclareProperty("photoelectric", photoelectric_,
       "Switch on/off the photoelectric effect.");
 
+    msg_->DeclareProperty("bulk_drift", bulk_drift_,
+      "Drift the ionization electrons all at once, tracking only those reaching the EL region.");
+
+    msg_->DeclarePropertyWithUnit("bulk_drift_binning", "mm", bulk_length_bin_,
+      "Size of the bins used to merge the electrons after the bulk drift (0 = no merging).");
+
+    msg_->DeclarePropertyWithUnit("bulk_drift_time_binning", "ns", bulk_time_bin_,
+      "Time width of the bins used to merge the electrons after the bulk drift.");
+
+    msg_->DeclareProperty("el_table", el_table_name_,
+      "EL look-up table used to simulate the EL light without optical photons.");
+
+    msg_->DeclareProperty("el_region", el_region_name_,
+      "Region where the EL light is simulated with the look-up table.");
+
+    msg_->DeclarePropertyWithUnit("el_table_radius", "mm", el_table_radius_,
+      "Radius of the circle covered by the EL points of the look-up table.");
+
+    msg_->DeclarePropertyWithUnit("el_table_pitch", "mm", el_table_pitch_,
+      "Distance between the EL points of the look-up table.");
+
   }
 
 
@@ -58,6 +88,7 @@ namespace nexus {
   NexusPhysics::~NexusPhysics()
   {
     delete msg_;
+    delete el_table_;
   }
 
 
@@ -109,12 +140,40 @@ namespace nexus {
       pmanager->AddDiscreteProcess(el);
     }
 
+    // Replace the EL photons by the response of the sensors
+    // given by a look-up table, if one is provided
+
+    if (el_table_name_ != "") {
+      G4Region* el_region =
+        G4RegionStore::GetInstance()->GetRegion(el_region_name_, false);
+      if (!el_region) {
+        G4String msg = "Region " + el_region_name_ + " not found.";
+        G4Exception("[NexusPhysics]", "ConstructProcess()", FatalException, msg);
+      }
+
+      // The table is loaded only once and shared by all threads,
+      // whereas every thread needs its own model
+      {
+        G4AutoLock lock(&el_table_mutex_);
+        if (!el_table_)
+          el_table_ = new ELLookupTable(el_table_name_, el_table_radius_,
+                                        el_table_pitch_);
+      }
+      new ELParamSimulation(el_region, el_table_);
+
+      G4FastSimulationManagerProcess* fastsim =
+        new G4FastSimulationManagerProcess("ELParamSimulation");
+      pmanager->AddDiscreteProcess(fastsim);
+    }
+
 
     // Add clustering to all pertinent particles
 
     if (clustering_) {
 
       IonizationClustering* clust = new IonizationClustering();
+      clust->SetBulkDrift(bulk_drift_);
+      clust->SetBulkDriftBinning(bulk_length_bin_, bulk_time_bin_);
 
       auto aParticleIterator = GetParticleIterator();
       aParticleIterator->reset();
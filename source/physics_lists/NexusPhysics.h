@@ -10,12 +10,15 @@
 #define NEXUS_PHYSICS_H
 
 #include <G4VPhysicsConstructor.hh>
+#include <G4Threading.hh>
 
 class G4GenericMessenger;
 
 
 namespace nexus {
 
+  class ELLookupTable;
+
   class NexusPhysics: public G4VPhysicsConstructor
   {
   public:
@@ -35,6 +38,18 @@ namespace nexus {
     G4bool electroluminescence_; ///< Switch on/off the electroluminescence
     G4bool photoelectric_;       ///< Switch on/off the photoelectric effect
 
+    G4bool bulk_drift_;          ///< Switch on/off the bulk drift of the ie-
+    G4double bulk_length_bin_;   ///< Spatial bin size for merging drifted ie-
+    G4double bulk_time_bin_;     ///< Time bin size for merging drifted ie-
+
+    G4String el_table_name_;  ///< File of the EL look-up table (fast simulation)
+    G4String el_region_name_; ///< Region where the EL fast simulation applies
+    G4double el_table_radius_; ///< Radius of the grid of EL points of the table
+    G4double el_table_pitch_;  ///< Distance between the EL points of the table
+
+    ELLookupTable* el_table_; ///< EL look-up table, shared by all threads
+    G4Mutex el_table_mutex_;
+
     G4GenericMessenger* msg_;
   };
 
@@ -13,7 +13,7 @@
 namespace nexus {
 
 
-  G4Allocator<IonizationHit> IonizationHitAllocator;
+  G4ThreadLocal G4Allocator<IonizationHit>* IonizationHitAllocator = 0;
 
 
 
@@ -61,16 +61,17 @@ namespace nexus {
 
 
   typedef G4THitsCollection<IonizationHit> IonizationHitsCollection;
-  extern G4Allocator<IonizationHit> IonizationHitAllocator;
+  extern G4ThreadLocal G4Allocator<IonizationHit>* IonizationHitAllocator;
 
 
   // INLINE DEFINITIONS //////////////////////////////////////////////
 
   inline void* IonizationHit::operator new(size_t)
-  { return ((void*) IonizationHitAllocator.MallocSingle()); }
+  { if (!IonizationHitAllocator) IonizationHitAllocator = new G4Allocator<IonizationHit>;
+    return ((void*) IonizationHitAllocator->MallocSingle()); }
 
   inline void IonizationHit::operator delete(void* aHit)
-  { IonizationHitAllocator.FreeSingle((IonizationHit*) aHit); }
+  { IonizationHitAllocator->FreeSingle((IonizationHit*) aHit); }
 
   inline G4int IonizationHit::GetTrackID() { return track_id_; }
   inline void IonizationHit::SetTrackID(G4int id) { track_id_ = id; }
@@ -2,6 +2,9 @@
 // nexus | IonizationSD.cc
 //
 // This class is the sensitive detector that creates ionization hits.
+// Optionally, the energy deposits can be merged into voxels (per track
+// or per event), in which case the hits are created at the end of the
+// event, one per voxel, at the energy-weighted centroid of its deposits.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -16,12 +19,22 @@
 #include <G4SDManager.hh>
 #include <G4Step.hh>
 #include <G4OpticalPhoton.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <cmath>
 
 
 
 using namespace nexus;
 
 
+// The merging settings are set (in the master thread) before the run
+// starts and are common to all the ionization detectors
+IonizationSD::MergeMode IonizationSD::merge_mode_ = IonizationSD::NO_MERGING;
+G4double IonizationSD::voxel_size_ = 1. * mm;
+G4double IonizationSD::time_window_ = 1. * microsecond;
+
+
 
 IonizationSD::IonizationSD(const G4String& name):
   G4VSensitiveDetector(name), include_(true)
@@ -57,6 +70,9 @@ void IonizationSD::Initialize(G4HCofThisEvent* hce)
     G4SDManager::GetSDMpointer()->GetCollectionID(SensitiveDetectorName+"/"+collectionName[0]);
   hce->AddHitsCollection(hcid, IHC_);
 
+  // Discard the voxels of an aborted event, if any
+  voxels_.clear();
+  voxel_index_.clear();
 }
 
 
@@ -74,15 +90,8 @@ G4bool IonizationSD::ProcessHits(G4Step* step, G4TouchableHistory*)
   // Discard steps where no energy was deposited in the detector
   if (edep <= 0.) return false;
 
-  // Create a hit and set its properties
-  IonizationHit* hit = new IonizationHit();
-  hit->SetTrackID(step->GetTrack()->GetTrackID());
-  hit->SetTime(step->GetTrack()->GetGlobalTime());
-  hit->SetEnergyDeposit(edep);
-  hit->SetPosition(step->GetPostStepPoint()->GetPosition());
-
-  // Add hit to collection
-  IHC_->insert(hit);
+  AddDeposit(track->GetTrackID(), step->GetPostStepPoint()->GetPosition(),
+             track->GetGlobalTime(), edep);
 
   // Add energy deposit to the trajectory associated
   // to the current track
@@ -100,6 +109,107 @@ G4bool IonizationSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 
 
 
+void IonizationSD::AddDeposit(G4int track_id, const G4ThreeVector& position,
+                              G4double time, G4double edep)
+{
+  if (merge_mode_ == NO_MERGING) {
+    // Create a hit and set its properties
+    IonizationHit* hit = new IonizationHit();
+    hit->SetTrackID(track_id);
+    hit->SetTime(time);
+    hit->SetEnergyDeposit(edep);
+    hit->SetPosition(position);
+
+    // Add hit to collection
+    IHC_->insert(hit);
+    return;
+  }
+
+  VoxelKey key;
+  key.track_id = (merge_mode_ == MERGE_BY_TRACK) ? track_id : 0;
+  key.ix = std::floor(position.x() / voxel_size_);
+  key.iy = std::floor(position.y() / voxel_size_);
+  key.iz = std::floor(position.z() / voxel_size_);
+  key.it = std::floor(time / time_window_);
+
+  auto result = voxel_index_.emplace(key, voxels_.size());
+  if (result.second) {
+    Voxel voxel = {track_id, edep, 0., 0., 0., 0., 0.};
+    voxels_.push_back(voxel);
+  }
+
+  Voxel& voxel = voxels_[result.first->second];
+  voxel.edep += edep;
+  voxel.x += edep * position.x();
+  voxel.y += edep * position.y();
+  voxel.z += edep * position.z();
+  voxel.t += edep * time;
+  if (edep > voxel.max_edep) {
+    voxel.max_edep = edep;
+    voxel.track_id = track_id;
+  }
+}
+
+
+
 void IonizationSD::EndOfEvent(G4HCofThisEvent*)
 {
+  // One hit per voxel, at the centroid of its deposits
+  for (const Voxel& voxel: voxels_) {
+    IonizationHit* hit = new IonizationHit();
+    hit->SetTrackID(voxel.track_id);
+    hit->SetTime(voxel.t / voxel.edep);
+    hit->SetEnergyDeposit(voxel.edep);
+    hit->SetPosition(G4ThreeVector(voxel.x, voxel.y, voxel.z) / voxel.edep);
+    IHC_->insert(hit);
+  }
+
+  voxels_.clear();
+  voxel_index_.clear();
+}
+
+
+
+void IonizationSD::SetMergeMode(const G4String& mode)
+{
+  if      (mode == "none")  merge_mode_ = NO_MERGING;
+  else if (mode == "track") merge_mode_ = MERGE_BY_TRACK;
+  else if (mode == "event") merge_mode_ = MERGE_BY_EVENT;
+  else {
+    G4Exception("[IonizationSD]", "SetMergeMode()", FatalErrorInArgument,
+                ("Unknown merging mode: " + mode).c_str());
+  }
+}
+
+
+
+void IonizationSD::SetVoxelSize(G4double size)
+{
+  if (size <= 0.) {
+    G4Exception("[IonizationSD]", "SetVoxelSize()", FatalErrorInArgument,
+                "The voxel size must be positive.");
+  }
+  voxel_size_ = size;
+}
+
+
+
+void IonizationSD::SetTimeWindow(G4double window)
+{
+  // Without time binning, prompt and delayed (e.g., from a radioactive
+  // decay) deposits in the same place would be merged into one hit
+  if (window <= 0.) {
+    G4Exception("[IonizationSD]", "SetTimeWindow()", FatalErrorInArgument,
+                "The time window must be positive.");
+  }
+  time_window_ = window;
+}
+
+
+
+G4VSensitiveDetector* IonizationSD::Clone() const
+{
+  IonizationSD* clone = new IonizationSD(fullPathName);
+  clone->IncludeInTotalEnergyDeposit(include_);
+  return clone;
 }
@@ -2,6 +2,9 @@
 // nexus | IonizationSD.h
 //
 // This class is the sensitive detector that creates ionization hits.
+// Optionally, the energy deposits can be merged into voxels (per track
+// or per event), in which case the hits are created at the end of the
+// event, one per voxel, at the energy-weighted centroid of its deposits.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -12,6 +15,9 @@
 #include <G4VSensitiveDetector.hh>
 #include "IonizationHit.h"
 
+#include <unordered_map>
+#include <vector>
+
 class G4Step;
 class G4HCofThisEvent;
 class G4TouchableHistory;
@@ -24,6 +30,9 @@ namespace nexus {
   class IonizationSD: public G4VSensitiveDetector
   {
   public:
+    /// How the energy deposits are turned into hits
+    enum MergeMode { NO_MERGING, MERGE_BY_TRACK, MERGE_BY_EVENT };
+
     /// Constructor
     IonizationSD(const G4String& sdname);
     /// Destructor
@@ -33,8 +42,13 @@ namespace nexus {
     /// in this method to the G4HCofThisEvent object.
     virtual void Initialize(G4HCofThisEvent*);
 
+    /// Creates the hits of the merged deposits, if any
     void EndOfEvent(G4HCofThisEvent*);
 
+    /// Returns a new sensitive detector with the same configuration.
+    /// Used to give every worker thread its own instance.
+    virtual G4VSensitiveDetector* Clone() const;
+
     /// Return the unique name of the hits collection created
     /// by this sensitive detector. This will be used by the persistency
     /// manager to fetch the collection from the G4HCofThisEvent object.
@@ -42,19 +56,79 @@ namespace nexus {
 
     void IncludeInTotalEnergyDeposit(G4bool);
 
+    /// Record an energy deposit of a track, either as a hit
+    /// or in its voxel, depending on the merging mode
+    void AddDeposit(G4int track_id, const G4ThreeVector& position,
+                    G4double time, G4double edep);
+
+    /// Set the merging mode of all the ionization detectors:
+    /// "none" (one hit per step), "track" or "event"
+    static void SetMergeMode(const G4String&);
+    /// Set the size of the voxels (cubic) deposits are merged into
+    static void SetVoxelSize(G4double);
+    /// Set the time window of the voxels (1 microsecond by default)
+    static void SetTimeWindow(G4double);
+
   private:
     ///
     virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
 
+    /// Position of a voxel in space, time and (optionally) track.
+    /// The time bin is kept as a (floored) double, since decay products
+    /// can be delayed far beyond the range of an integer bin.
+    struct VoxelKey {
+      G4int track_id;
+      G4long ix, iy, iz;
+      G4double it;
+
+      bool operator==(const VoxelKey&) const;
+    };
+
+    struct VoxelKeyHash {
+      size_t operator()(const VoxelKey&) const;
+    };
+
+    /// Deposits accumulated in a voxel
+    struct Voxel {
+      G4int track_id;     ///< Track with the largest single deposit
+      G4double max_edep;  ///< Largest single deposit
+      G4double edep;      ///< Total energy
+      G4double x, y, z, t; ///< Energy-weighted sums
+    };
+
   private:
     IonizationHitsCollection* IHC_;
     G4String det_name_;
     G4bool include_;
+
+    /// Voxels of the event (in order of creation) and their index
+    std::vector<Voxel> voxels_;
+    std::unordered_map<VoxelKey, size_t, VoxelKeyHash> voxel_index_;
+
+    static MergeMode merge_mode_;
+    static G4double voxel_size_;
+    static G4double time_window_;
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
   inline void IonizationSD::IncludeInTotalEnergyDeposit(G4bool inc)
   { include_ = inc; }
 
+  inline bool IonizationSD::VoxelKey::operator==(const VoxelKey& other) const
+  { return track_id == other.track_id && ix == other.ix && iy == other.iy
+      && iz == other.iz && it == other.it; }
+
+  inline size_t IonizationSD::VoxelKeyHash::operator()(const VoxelKey& k) const
+  {
+    size_t h = std::hash<G4long>()(k.ix);
+    h = h * 1000003 ^ std::hash<G4long>()(k.iy);
+    h = h * 1000003 ^ std::hash<G4long>()(k.iz);
+    h = h * 1000003 ^ std::hash<G4double>()(k.it);
+    h = h * 1000003 ^ std::hash<G4int>()(k.track_id);
+    return h;
+  }
+
 } // end namespace nexus
 
 #endif
@@ -1,30 +1,36 @@
 // ----------------------------------------------------------------------------
 // nexus | SensorHit.cc
 //
-// This class describes the charge detected by a photosensor.
+// This class describes the charge detected by a photosensor. The waveform
+// is stored sparsely, as fixed-size chunks of consecutive time bins keyed
+// by their index, so that its memory is bounded by the occupied bins.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 #include "SensorHit.h"
 
+#include <algorithm>
+
 
 using namespace nexus;
 
 
-G4Allocator<SensorHit> SensorHitAllocator;
+G4ThreadLocal G4Allocator<SensorHit>* SensorHitAllocator = 0;
 
 
 
 SensorHit::SensorHit():
-  G4VHit(), pmt_id_(-1.), bin_size_(0.)
+  G4VHit(), pmt_id_(-1.), bin_size_(0.), first_bin_(0), last_bin_(0),
+  last_key_(0), last_chunk_(0)
 {
 }
 
 
 
 SensorHit::SensorHit(G4int id, const G4ThreeVector& position, G4double bin_size):
-  G4VHit(), pmt_id_(id),  bin_size_(bin_size), position_(position)
+  G4VHit(), pmt_id_(id),  bin_size_(bin_size), position_(position),
+  first_bin_(0), last_bin_(0), last_key_(0), last_chunk_(0)
 {
 }
 
@@ -48,7 +54,12 @@ const SensorHit& SensorHit::operator=(const SensorHit& other)
   pmt_id_    = other.pmt_id_;
   bin_size_  = other.bin_size_;
   position_  = other.position_;
-  histogram_ = other.histogram_;
+  chunks_    = other.chunks_;
+  first_bin_ = other.first_bin_;
+  last_bin_  = other.last_bin_;
+
+  // The cached chunk of the other hit is not ours
+  last_chunk_ = 0;
 
   return *this;
 }
@@ -64,7 +75,7 @@ G4int SensorHit::operator==(const SensorHit& other) const
 
 void SensorHit::SetBinSize(G4double bin_size)
 {
-  if (histogram_.size() == 0) {
+  if (chunks_.empty()) {
     bin_size_ = bin_size;
   }
   else {
@@ -75,8 +86,41 @@ void SensorHit::SetBinSize(G4double bin_size)
 
 
 
+G4int SensorHit::GetCounts(G4long bin) const
+{
+  G4long key = ChunkKey(bin);
+  ChunkMap::const_iterator it = chunks_.find(key);
+  return (it == chunks_.end()) ? 0 : it->second[bin - key * CHUNK_BINS];
+}
+
+
+
 void SensorHit::Fill(G4double time, G4int counts)
 {
-  G4double time_bin = floor(time/bin_size_) * bin_size_;
-  histogram_[time_bin] += counts;
+  G4long bin = (G4long) floor(time/bin_size_);
+  G4long key = ChunkKey(bin);
+
+  if (chunks_.empty()) {
+    first_bin_ = last_bin_ = bin;
+  }
+  else {
+    first_bin_ = std::min(first_bin_, bin);
+    last_bin_  = std::max(last_bin_,  bin);
+  }
+
+  if (!last_chunk_ || key != last_key_) {
+    // A new chunk is value-initialized, that is, empty
+    last_chunk_ = &chunks_[key];
+    last_key_ = key;
+  }
+
+  (*last_chunk_)[bin - key * CHUNK_BINS] += counts;
+}
+
+
+
+G4long SensorHit::ChunkKey(G4long bin)
+{
+  // Rounded down, also for (unusual) negative bins
+  return (bin >= 0) ? bin / CHUNK_BINS : -((-bin - 1) / CHUNK_BINS) - 1;
 }
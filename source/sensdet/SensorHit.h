@@ -1,7 +1,9 @@
 // ----------------------------------------------------------------------------
 // nexus | SensorHit.h
 //
-// This class describes the charge detected by a photosensor.
+// This class describes the charge detected by a photosensor. The waveform
+// is stored sparsely, as fixed-size chunks of consecutive time bins keyed
+// by their index, so that its memory is bounded by the occupied bins.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -14,11 +16,45 @@
 #include <G4Allocator.hh>
 #include <G4ThreeVector.hh>
 
+#include <array>
+#include <map>
+#include <utility>
+#include <iterator>
+
 
 namespace nexus {
 
   class SensorHit: public G4VHit
   {
+  public:
+    /// Number of time bins per chunk of the waveform
+    static const G4int CHUNK_BINS = 64;
+    typedef std::array<G4int, CHUNK_BINS> Chunk;
+    typedef std::map<G4long, Chunk> ChunkMap;
+
+    /// Iterator over the non-empty bins of the waveform. It points
+    /// to pairs (time bin index, counts).
+    class const_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef std::pair<G4long, G4int> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef value_type reference;
+
+      const_iterator(const SensorHit* hit, ChunkMap::const_iterator chunk);
+      std::pair<G4long, G4int> operator*() const;
+      const_iterator& operator++();
+      bool operator!=(const const_iterator&) const;
+      bool operator==(const const_iterator&) const;
+    private:
+      void SkipEmpty();
+      const SensorHit* hit_;
+      ChunkMap::const_iterator chunk_;
+      size_t pos_; ///< Position of the bin within its chunk
+    };
+
   public:
     /// Default constructor
     SensorHit();
@@ -55,25 +91,48 @@ namespace nexus {
     /// while the histogram is empty (rebinning is not supported).
     void SetBinSize(G4double);
 
-    /// Adds counts to a given time bin
+    /// Adds counts to the time bin of the given time
     void Fill(G4double time, G4int counts=1);
 
-    const std::map<G4double, G4int>& GetHistogram() const;
+    /// Returns an iterator to the first non-empty bin of the waveform
+    const_iterator begin() const;
+    /// Returns the past-the-end iterator of the waveform
+    const_iterator end() const;
+
+    /// Returns the index of the first time bin of the waveform window
+    G4long GetFirstBin() const;
+    /// Returns the index of the last time bin of the waveform window
+    G4long GetLastBin() const;
+    /// Returns the counts of the given time bin
+    G4int GetCounts(G4long bin) const;
+    /// Returns whether the waveform has no counts
+    G4bool IsEmpty() const;
+
+  private:
+    /// Returns the index of the chunk of the given time bin
+    static G4long ChunkKey(G4long bin);
 
   private:
     G4int pmt_id_;           ///< Detector ID number
     G4double bin_size_;      ///< Size of time bin
     G4ThreeVector position_; ///< Detector position
 
-    /// Sparse histogram with number of photons detected per time bin
-    std::map<G4double, G4int> histogram_;
+    /// Number of photons detected per time bin, in chunks of
+    /// CHUNK_BINS bins keyed by the index of the chunk
+    ChunkMap chunks_;
+    G4long first_bin_; ///< Index of the first time bin filled
+    G4long last_bin_;  ///< Index of the last time bin filled
+
+    /// Chunk filled last (photons arrive roughly in time order)
+    G4long last_key_;
+    Chunk* last_chunk_;
   };
 
 } // namespace nexus
 
 
 typedef G4THitsCollection<nexus::SensorHit> SensorHitsCollection;
-extern G4Allocator<nexus::SensorHit> SensorHitAllocator;
+extern G4ThreadLocal G4Allocator<nexus::SensorHit>* SensorHitAllocator;
 
 
 // INLINE DEFINITIONS ////////////////////////////////////////////////
@@ -81,10 +140,11 @@ extern G4Allocator<nexus::SensorHit> SensorHitAllocator;
 namespace nexus {
 
   inline void* SensorHit::operator new(size_t)
-  { return ((void*) SensorHitAllocator.MallocSingle()); }
+  { if (!SensorHitAllocator) SensorHitAllocator = new G4Allocator<SensorHit>;
+    return ((void*) SensorHitAllocator->MallocSingle()); }
 
   inline void SensorHit::operator delete(void* hit)
-  { SensorHitAllocator.FreeSingle((SensorHit*) hit); }
+  { SensorHitAllocator->FreeSingle((SensorHit*) hit); }
 
   inline G4int SensorHit::GetPmtID() const { return pmt_id_; }
   inline void SensorHit::SetPmtID(G4int id) { pmt_id_ = id; }
@@ -94,8 +154,40 @@ namespace nexus {
   inline G4ThreeVector SensorHit::GetPosition() const { return position_; }
   inline void SensorHit::SetPosition(const G4ThreeVector& p) { position_ = p; }
 
-  inline const std::map<G4double, G4int>& SensorHit::GetHistogram() const
-  { return histogram_; }
+  inline G4long SensorHit::GetFirstBin() const { return first_bin_; }
+  inline G4long SensorHit::GetLastBin() const { return last_bin_; }
+
+  inline G4bool SensorHit::IsEmpty() const { return chunks_.empty(); }
+
+  inline SensorHit::const_iterator SensorHit::begin() const
+  { return const_iterator(this, chunks_.begin()); }
+  inline SensorHit::const_iterator SensorHit::end() const
+  { return const_iterator(this, chunks_.end()); }
+
+  inline SensorHit::const_iterator::const_iterator(const SensorHit* hit,
+                                                   ChunkMap::const_iterator chunk):
+    hit_(hit), chunk_(chunk), pos_(0) { SkipEmpty(); }
+
+  inline void SensorHit::const_iterator::SkipEmpty()
+  {
+    while (chunk_ != hit_->chunks_.end()) {
+      while (pos_ < (size_t) CHUNK_BINS && chunk_->second[pos_] == 0) ++pos_;
+      if (pos_ < (size_t) CHUNK_BINS) return;
+      ++chunk_;
+      pos_ = 0;
+    }
+  }
+
+  inline std::pair<G4long, G4int> SensorHit::const_iterator::operator*() const
+  { return std::make_pair(chunk_->first * CHUNK_BINS + (G4long) pos_, chunk_->second[pos_]); }
+
+  inline SensorHit::const_iterator& SensorHit::const_iterator::operator++()
+  { ++pos_; SkipEmpty(); return *this; }
+
+  inline bool SensorHit::const_iterator::operator!=(const const_iterator& other) const
+  { return chunk_ != other.chunk_ || pos_ != other.pos_; }
+  inline bool SensorHit::const_iterator::operator==(const const_iterator& other) const
+  { return !(*this != other); }
 
 } // namespace nexus
 
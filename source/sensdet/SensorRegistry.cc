@@ -0,0 +1,161 @@
+// ----------------------------------------------------------------------------
+// nexus | SensorRegistry.cc
+//
+// This class keeps the list of all the photosensors of the geometry,
+// with their id, name and global position. The geometries owning sensors
+// register their sensitive volumes while being constructed; the sensors
+// are then located once the whole geometry is placed in the world.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SensorRegistry.h"
+
+#include "SensorSD.h"
+
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+
+#include <algorithm>
+
+
+namespace nexus {
+
+
+  SensorRegistry& SensorRegistry::Instance()
+  {
+    static SensorRegistry registry;
+    return registry;
+  }
+
+
+
+  SensorRegistry::SensorRegistry(): built_(false), min_id_(0)
+  {
+  }
+
+
+
+  SensorRegistry::~SensorRegistry()
+  {
+  }
+
+
+
+  void SensorRegistry::RegisterSensorVolume(G4LogicalVolume* lv)
+  {
+    if (!dynamic_cast<SensorSD*>(lv->GetSensitiveDetector())) {
+      G4String msg = "Volume " + lv->GetName() + " has no SensorSD attached.";
+      G4Exception("[SensorRegistry]", "RegisterSensorVolume()",
+                  FatalException, msg);
+    }
+    volumes_.insert(lv);
+  }
+
+
+
+  void SensorRegistry::Build(G4VPhysicalVolume* world)
+  {
+    sensors_.clear();
+    contains_sensors_.clear();
+
+    std::vector<G4int> copy_numbers;
+    FindSensors(world, G4ThreeVector(), G4RotationMatrix(), copy_numbers);
+
+    std::sort(sensors_.begin(), sensors_.end(),
+              [](const SensorInfo& a, const SensorInfo& b) { return a.id < b.id; });
+
+    // Check that the ids are unique
+    for (size_t i=1; i<sensors_.size(); i++) {
+      if (sensors_[i].id == sensors_[i-1].id) {
+        G4String msg = "Duplicated sensor id " + std::to_string(sensors_[i].id);
+        G4Exception("[SensorRegistry]", "Build()", FatalException, msg);
+      }
+    }
+
+    // Build the index of the ids. A dense array is used unless
+    // the ids are too sparse (or too many) for it.
+    dense_index_.clear();
+    sparse_index_.clear();
+    min_id_ = 0;
+
+    if (!sensors_.empty()) {
+      min_id_ = sensors_.front().id;
+      size_t range = sensors_.back().id - min_id_ + 1;
+      if (range <= std::max<size_t>(16 * sensors_.size(), 1 << 16)) {
+        dense_index_.assign(range, -1);
+        for (size_t i=0; i<sensors_.size(); i++)
+          dense_index_[sensors_[i].id - min_id_] = i;
+      }
+      else {
+        for (size_t i=0; i<sensors_.size(); i++)
+          sparse_index_[sensors_[i].id] = i;
+      }
+    }
+
+    built_ = true;
+  }
+
+
+
+  void SensorRegistry::FindSensors(G4VPhysicalVolume* pv,
+                                   const G4ThreeVector& translation,
+                                   const G4RotationMatrix& rotation,
+                                   std::vector<G4int>& copy_numbers)
+  {
+    G4LogicalVolume* lv = pv->GetLogicalVolume();
+
+    // Skip the branches of the tree without sensors
+    if (!ContainsSensors(lv)) return;
+
+    if (pv->IsReplicated()) {
+      G4String msg = "Sensors inside the replicated volume " + pv->GetName()
+        + " cannot be located.";
+      G4Exception("[SensorRegistry]", "FindSensors()", JustWarning, msg);
+      return;
+    }
+
+    // Global placement of the volume
+    G4ThreeVector position = translation + rotation * pv->GetObjectTranslation();
+    G4RotationMatrix rot = rotation * pv->GetObjectRotationValue();
+
+    copy_numbers.push_back(pv->GetCopyNo());
+
+    // Sensors are identified as in SensorSD, from the copy numbers
+    // of the volumes at the configured depths (0 being the current one)
+    if (volumes_.count(lv)) {
+      SensorSD* sd = static_cast<SensorSD*>(lv->GetSensitiveDetector());
+      G4int depth = copy_numbers.size() - 1;
+      G4int id = copy_numbers[depth - sd->GetDetectorVolumeDepth()];
+      if (sd->GetDetectorNamingOrder() != 0)
+        id += sd->GetDetectorNamingOrder() *
+          copy_numbers[depth - sd->GetMotherVolumeDepth()];
+
+      SensorInfo sensor = {id, sd->GetName(), position, lv};
+      sensors_.push_back(sensor);
+    }
+
+    for (size_t i=0; i<lv->GetNoDaughters(); i++)
+      FindSensors(lv->GetDaughter(i), position, rot, copy_numbers);
+
+    copy_numbers.pop_back();
+  }
+
+
+
+  G4bool SensorRegistry::ContainsSensors(G4LogicalVolume* lv)
+  {
+    std::map<G4LogicalVolume*, G4bool>::const_iterator it =
+      contains_sensors_.find(lv);
+    if (it != contains_sensors_.end()) return it->second;
+
+    G4bool result = volumes_.count(lv) > 0;
+    for (size_t i=0; i<lv->GetNoDaughters() && !result; i++)
+      result = ContainsSensors(lv->GetDaughter(i)->GetLogicalVolume());
+
+    contains_sensors_[lv] = result;
+    return result;
+  }
+
+
+} // end namespace nexus
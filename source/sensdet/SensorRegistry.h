@@ -0,0 +1,113 @@
+// ----------------------------------------------------------------------------
+// nexus | SensorRegistry.h
+//
+// This class keeps the list of all the photosensors of the geometry,
+// with their id, name and global position. The geometries owning sensors
+// register their sensitive volumes while being constructed; the sensors
+// are then located once the whole geometry is placed in the world.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <G4ThreeVector.hh>
+#include <G4RotationMatrix.hh>
+#include <globals.hh>
+
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class SensorRegistry
+  {
+  public:
+    /// Description of a sensor
+    struct SensorInfo {
+      G4int id;               ///< Sensor id, as given by SensorSD
+      G4String name;          ///< Name of the sensitive detector
+      G4ThreeVector position; ///< Global position of the sensitive volume
+      G4LogicalVolume* volume; ///< Sensitive volume
+    };
+
+  public:
+    /// Return the (Meyers-style) singleton instance of the registry
+    static SensorRegistry& Instance();
+
+    /// Register a logical volume whose sensitive detector is a SensorSD.
+    /// Invoked by the sensor geometries on construction.
+    void RegisterSensorVolume(G4LogicalVolume*);
+
+    /// Locate all the placements of the registered volumes in the
+    /// geometry tree below the given world volume, computing the id
+    /// and global position of every sensor. Invoked (in the master
+    /// thread) once the geometry is constructed.
+    void Build(G4VPhysicalVolume* world);
+
+    /// Return true once the sensors have been located
+    G4bool IsBuilt() const;
+
+    /// Return the number of sensors
+    G4int GetNumberOfSensors() const;
+    /// Return the sensor with the given (dense) index, in [0, n)
+    const SensorInfo& GetSensor(G4int index) const;
+    /// Return the dense index of the sensor with the given id,
+    /// or -1 if the sensor is unknown
+    G4int GetIndex(G4int sensor_id) const;
+
+  private:
+    SensorRegistry();
+    ~SensorRegistry();
+
+    void FindSensors(G4VPhysicalVolume*, const G4ThreeVector&,
+                     const G4RotationMatrix&, std::vector<G4int>&);
+    G4bool ContainsSensors(G4LogicalVolume*);
+
+  private:
+    std::set<G4LogicalVolume*> volumes_; ///< Registered sensitive volumes
+    std::map<G4LogicalVolume*, G4bool> contains_sensors_;
+
+    G4bool built_;
+    std::vector<SensorInfo> sensors_; ///< Sensors, sorted by id
+
+    // Index of every sensor id: a dense array when the ids
+    // are compact enough, a hash table otherwise
+    G4int min_id_;
+    std::vector<G4int> dense_index_;
+    std::unordered_map<G4int, G4int> sparse_index_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4bool SensorRegistry::IsBuilt() const
+  { return built_; }
+
+  inline G4int SensorRegistry::GetNumberOfSensors() const
+  { return sensors_.size(); }
+
+  inline const SensorRegistry::SensorInfo&
+  SensorRegistry::GetSensor(G4int index) const
+  { return sensors_[index]; }
+
+  inline G4int SensorRegistry::GetIndex(G4int sensor_id) const
+  {
+    if (!dense_index_.empty()) {
+      size_t i = sensor_id - min_id_;
+      return (i < dense_index_.size()) ? dense_index_[i] : -1;
+    }
+    std::unordered_map<G4int, G4int>::const_iterator it =
+      sparse_index_.find(sensor_id);
+    return (it != sparse_index_.end()) ? it->second : -1;
+  }
+
+} // end namespace nexus
+
+#endif
@@ -8,13 +8,13 @@
 // ----------------------------------------------------------------------------
 
 #include "SensorSD.h"
+#include "SensorRegistry.h"
 
 #include <G4OpticalPhoton.hh>
 #include <G4SDManager.hh>
 #include <G4ProcessManager.hh>
 #include <G4OpBoundaryProcess.hh>
 #include <G4RunManager.hh>
-#include <G4RunManager.hh>
 
 
 namespace nexus {
@@ -52,6 +52,13 @@ namespace nexus {
       GetCollectionID(this->GetName()+"/"+this->GetCollectionName(0));
 
     HCE->AddHitsCollection(HCID, HC_);
+
+    // Reset the hits of the previous event
+    size_t nsensors = SensorRegistry::Instance().GetNumberOfSensors();
+    if (hits_.size() != nsensors) hits_.assign(nsensors, 0);
+    for (G4int index: hits_in_use_) hits_[index] = 0;
+    hits_in_use_.clear();
+    hit_index_.clear();
   }
 
 
@@ -67,13 +74,18 @@ namespace nexus {
 
     G4int pmt_id = FindPmtID(touchable);
 
-    SensorHit* hit = 0;
-    for (size_t i=0; i<HC_->entries(); i++) {
-      if ((*HC_)[i]->GetPmtID() == pmt_id) {
-        hit = (*HC_)[i];
-        break;
-      }
-    }
+    G4double time = step->GetPostStepPoint()->GetGlobalTime();
+    RegisterPhoton(pmt_id, touchable->GetTranslation(), time);
+
+    return true;
+  }
+
+
+
+  void SensorSD::RegisterPhoton(G4int pmt_id, const G4ThreeVector& position,
+                                G4double time, G4int counts)
+  {
+    SensorHit*& hit = FindHit(pmt_id);
 
     // If no hit associated to this sensor exists already,
     // create it and set main properties
@@ -81,14 +93,36 @@ namespace nexus {
       hit = new SensorHit();
       hit->SetPmtID(pmt_id);
       hit->SetBinSize(timebinning_);
-      hit->SetPosition(touchable->GetTranslation());
+      hit->SetPosition(position);
       HC_->insert(hit);
     }
 
-    G4double time = step->GetPostStepPoint()->GetGlobalTime();
-    hit->Fill(time);
+    hit->Fill(time, counts);
+  }
 
-    return true;
+
+
+  SensorHit*& SensorSD::FindHit(G4int pmt_id)
+  {
+    G4int index = SensorRegistry::Instance().GetIndex(pmt_id);
+    if (index < 0 || index >= (G4int) hits_.size())
+      return hit_index_[pmt_id];
+
+    SensorHit*& hit = hits_[index];
+    if (!hit) hits_in_use_.push_back(index);
+    return hit;
+  }
+
+
+
+  G4VSensitiveDetector* SensorSD::Clone() const
+  {
+    SensorSD* clone = new SensorSD(fullPathName);
+    clone->SetDetectorVolumeDepth(sensor_depth_);
+    clone->SetMotherVolumeDepth(mother_depth_);
+    clone->SetDetectorNamingOrder(naming_order_);
+    clone->SetTimeBinning(timebinning_);
+    return clone;
   }
 
 
@@ -13,6 +13,9 @@
 #include <G4VSensitiveDetector.hh>
 #include "SensorHit.h"
 
+#include <unordered_map>
+#include <vector>
+
 class G4Step;
 class G4HCofThisEvent;
 class G4VTouchable;
@@ -39,6 +42,10 @@ namespace nexus {
     /// Method invoked at the end of every event
     void EndOfEvent(G4HCofThisEvent*);
 
+    /// Returns a new sensitive detector with the same configuration.
+    /// Used to give every worker thread its own instance.
+    G4VSensitiveDetector* Clone() const;
+
     /// Set the depth of the sensitive detector in the geometry hierarchy
     void SetDetectorVolumeDepth(G4int);
     /// Return the depth of the sensitive detector in the volume hierarchy
@@ -57,6 +64,12 @@ namespace nexus {
     /// Set a time binning for the pmt hits
     void SetTimeBinning(G4double);
 
+    /// Add photons detected at the given time by a sensor, creating
+    /// its hit if needed. Invoked by ProcessHits for every optical photon,
+    /// and by the fast simulation of the EL light.
+    void RegisterPhoton(G4int pmt_id, const G4ThreeVector& position,
+                        G4double time, G4int counts=1);
+
     /// Return the unique name of the hits collection created
     /// by this sensitive detector. This will be used by the
     /// persistency manager to select the collection.
@@ -68,6 +81,9 @@ namespace nexus {
 
     G4int FindPmtID(const G4VTouchable*);
 
+    /// Return the hit of a sensor in the current event (null if none yet)
+    SensorHit*& FindHit(G4int pmt_id);
+
     G4int naming_order_; ///< Order of the naming scheme
     G4int sensor_depth_; ///< Depth of the SD in the geometry tree
     G4int mother_depth_; ///< Depth of the SD's mother in the geometry tree
@@ -75,6 +91,13 @@ namespace nexus {
     G4double timebinning_; ///< Time bin width
 
     SensorHitsCollection* HC_; ///< Pointer to the collection of hits
+
+    /// Hit of every sensor that detected light in the current event,
+    /// by index in the SensorRegistry (with the indices in use) or,
+    /// for sensors not registered, by id
+    std::vector<SensorHit*> hits_;
+    std::vector<G4int> hits_in_use_;
+    std::unordered_map<G4int, SensorHit*> hit_index_;
   };
 
   // INLINE METHODS //////////////////////////////////////////////////
@@ -41,3 +41,17 @@ TEST_CASE("XenonProperties::Density") {
   }
 
 }
+
+TEST_CASE("XenonProperties::Density benchmark", "[.][benchmark]") {
+  // Geometries build many xenon materials; compare reading the density
+  // table for every one of them with the lookup in the cached grid.
+
+  BENCHMARK("Reading the density table") {
+    std::vector<std::vector<G4double>> data;
+    return MakeXeDensityDataTable(data);
+  };
+
+  BENCHMARK("Density from the cached table") {
+    return GetGasDensity(15 * bar, 295 * kelvin);
+  };
+}
@@ -0,0 +1,98 @@
+#include <HDF5Writer.h>
+#include <hdf5_functions.h>
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+  void WriteParticle(nexus::HDF5Writer& writer, int event, const char* name,
+                     const char* volume, const char* proc)
+  {
+    writer.WriteParticleInfo(event, 1, name, 1, 0, 0., 0., 0., 0.,
+                             1., 1., 1., 1., volume, volume,
+                             0., 0., 1., 0., 0., 0., 1., 1.,
+                             "none", proc);
+  }
+
+  template <typename T>
+  std::vector<T> ReadTable(hid_t file, const char* name, hsize_t memtype)
+  {
+    hid_t dataset = H5Dopen2(file, name, H5P_DEFAULT);
+    hid_t space = H5Dget_space(dataset);
+    hsize_t nrows;
+    H5Sget_simple_extent_dims(space, &nrows, NULL);
+    std::vector<T> rows(nrows);
+    H5Dread(dataset, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, rows.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    return rows;
+  }
+
+}
+
+
+TEST_CASE("HDF5Writer Append") {
+
+  // This test checks that the rows buffered by writers with no file
+  // (as those of the worker threads) are appended to the writer of the
+  // file with their string codes translated into those of the file
+
+  std::string filename = "HDF5WriterTests.h5";
+
+  nexus::HDF5Writer file_writer;
+  file_writer.SetStringDictionary(true);
+  file_writer.Open(filename, false);
+
+  nexus::HDF5Writer rows1, rows2;
+  rows1.SetStringDictionary(true);
+  rows2.SetStringDictionary(true);
+
+  WriteParticle(rows1, 0, "e-", "ACTIVE", "eIoni");
+  WriteParticle(rows2, 1, "gamma", "BUFFER", "phot");
+  file_writer.Append(rows2);
+  file_writer.Append(rows1);
+  file_writer.Flush();
+
+  // Strings already known, and new ones, after the first append
+  WriteParticle(rows1, 2, "gamma", "ACTIVE", "compt");
+  file_writer.Append(rows1);
+  file_writer.Close();
+
+  hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  std::vector<string_dict_t> strings =
+    ReadTable<string_dict_t>(file, "/MC/string_dict", createStringDictType());
+  std::vector<particle_code_t> particles =
+    ReadTable<particle_code_t>(file, "/MC/particles", createParticleCodeType());
+  H5Fclose(file);
+  std::remove(filename.c_str());
+
+  std::map<int32_t, std::string> dict;
+  for (const string_dict_t& entry: strings) {
+    REQUIRE(dict.count(entry.code) == 0);
+    dict[entry.code] = entry.value;
+  }
+  // "e-", "gamma", "ACTIVE", "BUFFER", "none", "eIoni", "phot", "compt"
+  REQUIRE(dict.size() == 8);
+
+  REQUIRE(particles.size() == 3);
+
+  std::map<int32_t, const particle_code_t*> events;
+  for (const particle_code_t& row: particles) events[row.event_id] = &row;
+
+  REQUIRE(dict[events[0]->particle_name]  == "e-");
+  REQUIRE(dict[events[0]->initial_volume] == "ACTIVE");
+  REQUIRE(dict[events[0]->final_proc]     == "eIoni");
+  REQUIRE(dict[events[1]->particle_name]  == "gamma");
+  REQUIRE(dict[events[1]->final_volume]   == "BUFFER");
+  REQUIRE(dict[events[1]->creator_proc]   == "none");
+  REQUIRE(dict[events[1]->final_proc]     == "phot");
+  REQUIRE(dict[events[2]->particle_name]  == "gamma");
+  REQUIRE(dict[events[2]->initial_volume] == "ACTIVE");
+  REQUIRE(dict[events[2]->final_proc]     == "compt");
+}
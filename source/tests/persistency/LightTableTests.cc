@@ -0,0 +1,29 @@
+#include <LightTable.h>
+
+#include <catch.hpp>
+
+
+TEST_CASE("LightTable") {
+
+  // This test checks that the events generated in the same point
+  // are accumulated together and normalized to all their photons
+
+  nexus::LightTable table;
+
+  G4ThreeVector p0(0., 0., 10.);
+  G4ThreeVector p1(0., 5., 10.);
+
+  G4int i0 = table.AddEvent(p0, 1000);
+  table.AddCharge(i0, 3, 0, 10);
+  G4int i1 = table.AddEvent(p1, 1000);
+  table.AddCharge(i1, 3, 0, 40);
+  REQUIRE(table.AddEvent(p0, 1000) == i0);
+  table.AddCharge(i0, 3, 1, 20);
+  table.AddCharge(i0, 7, 0, 2);
+
+  REQUIRE(table.GetNumberOfPoints() == 2);
+  REQUIRE(table.GetProbability(i0, 3) == Approx(0.015));
+  REQUIRE(table.GetProbability(i0, 7) == Approx(0.001));
+  REQUIRE(table.GetProbability(i1, 3) == Approx(0.04));
+  REQUIRE(table.GetProbability(i1, 7) == 0.);
+}
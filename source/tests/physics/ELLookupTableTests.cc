@@ -0,0 +1,157 @@
+#include <ELLookupTable.h>
+
+#include <G4StateManager.hh>
+#include <G4VExceptionHandler.hh>
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+  // Turns the G4Exceptions raised while it exists into C++ exceptions,
+  // so that fatal errors can be checked instead of aborting the tests
+  class ThrowingHandler: public G4VExceptionHandler
+  {
+  public:
+    G4bool Notify(const char*, const char*, G4ExceptionSeverity severity,
+                  const char* description)
+    {
+      if (severity == JustWarning) return false;
+      throw std::runtime_error(description);
+    }
+  };
+
+  struct ExceptionsThrown
+  {
+    G4VExceptionHandler* previous =
+      G4StateManager::GetStateManager()->GetExceptionHandler();
+    ThrowingHandler handler; // registers itself
+    ~ExceptionsThrown()
+    { G4StateManager::GetStateManager()->SetExceptionHandler(previous); }
+  };
+
+  // A grid of radius 10 mm and pitch 5 mm has 9 points (3 columns
+  // of 3 points around the center)
+  const G4double radius = 10.;
+  const G4double pitch  = 5.;
+  const G4int npoints = 9;
+
+  // Writes a text table in which every point is seen by two
+  // sensors, with probabilities encoding the point and the sensor
+  void WriteTextTable(const G4String& filename, G4int points)
+  {
+    std::ofstream file(filename);
+    file << "* EL table for the tests\n";
+    for (G4int point=0; point<points; point++) {
+      for (G4int sensor: {point, 100 + point}) {
+        file << point << " " << sensor;
+        for (G4int bin=0; bin<nexus::ELLookupTable::num_time_bins; bin++)
+          file << " " << 1.e-3 * sensor + 1.e-5 * bin;
+        file << "\n";
+      }
+    }
+  }
+
+}
+
+
+TEST_CASE("ELLookupTable") {
+
+  // This test checks the index of the grid, the reading of text tables
+  // and the round trip through the binary (memory-mapped) format
+
+  G4String text_file = "ELLookupTableTests.txt";
+  G4String binary_file = "ELLookupTableTests.bin";
+  WriteTextTable(text_file, npoints);
+
+  nexus::ELLookupTable text(text_file, radius, pitch);
+  std::remove(text_file.c_str());
+
+  REQUIRE(text.GetNumberOfPoints() == npoints);
+
+  SECTION("Index") {
+    // Points are numbered column by column, from the bottom up
+    REQUIRE(text.GetPointID(G4ThreeVector(-5., -5., 0.)) == 0);
+    REQUIRE(text.GetPointID(G4ThreeVector( 0.,  0., 0.)) == 4);
+    REQUIRE(text.GetPointID(G4ThreeVector( 5.,  5., 0.)) == 8);
+
+    // Positions out of the circle get the closest point
+    REQUIRE(text.GetPointID(G4ThreeVector(-10., -10., 0.)) == 0);
+    REQUIRE(text.GetPointID(G4ThreeVector( 10.,   0., 0.)) == 7);
+    REQUIRE(text.GetPointID(G4ThreeVector(  0., 100., 0.)) == 5);
+  }
+
+  SECTION("Binary round trip") {
+    text.WriteBinaryFile(binary_file);
+    nexus::ELLookupTable binary(binary_file, radius, pitch);
+    std::remove(binary_file.c_str());
+
+    REQUIRE(binary.GetNumberOfPoints() == npoints);
+    for (G4int point=0; point<npoints; point++) {
+      REQUIRE(binary.GetNumberOfSensors(point) == 2);
+      const nexus::ELLookupTable::SensorResponse* expected = text.GetSensors(point);
+      const nexus::ELLookupTable::SensorResponse* sensors = binary.GetSensors(point);
+      for (G4int i=0; i<2; i++) {
+        REQUIRE(sensors[i].sensor_id == expected[i].sensor_id);
+        for (G4int bin=0; bin<nexus::ELLookupTable::num_time_bins; bin++)
+          REQUIRE(sensors[i].probs[bin] == expected[i].probs[bin]);
+      }
+    }
+  }
+
+  SECTION("Wrong grid") {
+    // The point ids of a binary table are only valid for its own grid
+    text.WriteBinaryFile(binary_file);
+
+    ExceptionsThrown exceptions;
+    REQUIRE_THROWS_WITH(nexus::ELLookupTable(binary_file, radius, 2. * pitch),
+                        Catch::Contains("made for a grid"));
+    std::remove(binary_file.c_str());
+  }
+
+  SECTION("Wrong magic number") {
+    // The file is not taken as a binary table, nor can it be read as text
+    text.WriteBinaryFile(binary_file);
+    {
+      std::fstream file(binary_file, std::ios::in | std::ios::out | std::ios::binary);
+      file.write("NXELT99", 7);
+    }
+
+    ExceptionsThrown exceptions;
+    REQUIRE_THROWS(nexus::ELLookupTable(binary_file, radius, pitch));
+    std::remove(binary_file.c_str());
+  }
+
+  SECTION("Truncated file") {
+    text.WriteBinaryFile(binary_file);
+    std::vector<char> bytes;
+    {
+      std::ifstream file(binary_file, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream file(binary_file, std::ios::binary | std::ios::trunc);
+      file.write(bytes.data(), bytes.size() - 10);
+    }
+
+    ExceptionsThrown exceptions;
+    REQUIRE_THROWS_WITH(nexus::ELLookupTable(binary_file, radius, pitch),
+                        Catch::Contains("corrupted"));
+    std::remove(binary_file.c_str());
+  }
+
+  SECTION("Missing points") {
+    WriteTextTable(text_file, npoints - 1);
+
+    ExceptionsThrown exceptions;
+    REQUIRE_THROWS_WITH(nexus::ELLookupTable(text_file, radius, pitch),
+                        Catch::Contains("fewer points"));
+    std::remove(text_file.c_str());
+  }
+}
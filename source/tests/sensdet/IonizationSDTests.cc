@@ -0,0 +1,154 @@
+#include <IonizationSD.h>
+
+#include <G4SDManager.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <map>
+
+
+namespace {
+
+  // Sensitive detectors can only be registered once in the SD manager
+  nexus::IonizationSD* GetIonizationSD()
+  {
+    static nexus::IonizationSD* sd = nullptr;
+    if (!sd) {
+      sd = new nexus::IonizationSD("/TEST/IONIZATION");
+      G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+    }
+    return sd;
+  }
+
+}
+
+
+TEST_CASE("IonizationSD hit merging") {
+  // This test checks that merging the deposits into voxels
+  // reduces the number of hits but preserves the total energy
+
+  nexus::IonizationSD* sd = GetIonizationSD();
+  G4int HCID = G4SDManager::GetSDMpointer()->
+    GetCollectionID("/TEST/IONIZATION/" + nexus::IonizationSD::GetCollectionUniqueName());
+
+  // Deposits of two tracks along a 10-cm segment. The energy and
+  // the energy-weighted z of the deposits are summed per 1-mm voxel.
+  const G4int ndeposits = 10000;
+  std::map<G4long, std::pair<G4double, G4double>> voxel_sums;
+  auto FillEvent = [&](G4HCofThisEvent& hce) {
+    sd->Initialize(&hce);
+    voxel_sums.clear();
+    G4double total = 0.;
+    for (G4int i=0; i<ndeposits; ++i) {
+      G4double edep = G4UniformRand() * keV;
+      G4ThreeVector xyz(0., 0., 10. * cm * G4UniformRand());
+      sd->AddDeposit(1 + i % 2, xyz, xyz.z() / c_light, edep);
+      total += edep;
+      std::pair<G4double, G4double>& sums = voxel_sums[std::floor(xyz.z() / mm)];
+      sums.first  += edep;
+      sums.second += edep * xyz.z();
+    }
+    sd->EndOfEvent(&hce);
+    return total;
+  };
+
+  auto Sum = [](nexus::IonizationHitsCollection* hits) {
+    G4double sum = 0.;
+    for (size_t i=0; i<hits->entries(); ++i)
+      sum += (*hits)[i]->GetEnergyDeposit();
+    return sum;
+  };
+
+  SECTION("No merging") {
+    nexus::IonizationSD::SetMergeMode("none");
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    G4double total = FillEvent(hce);
+    nexus::IonizationHitsCollection* hits = (nexus::IonizationHitsCollection*) hce.GetHC(HCID);
+    REQUIRE(hits->entries() == (size_t) ndeposits);
+    REQUIRE(Sum(hits) == Approx(total));
+  }
+
+  SECTION("Merging by track") {
+    nexus::IonizationSD::SetMergeMode("track");
+    nexus::IonizationSD::SetVoxelSize(1. * mm);
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    G4double total = FillEvent(hce);
+    nexus::IonizationHitsCollection* hits = (nexus::IonizationHitsCollection*) hce.GetHC(HCID);
+    REQUIRE(hits->entries() == 200u);
+    REQUIRE(Sum(hits) == Approx(total));
+  }
+
+  SECTION("Merging by event") {
+    nexus::IonizationSD::SetMergeMode("event");
+    nexus::IonizationSD::SetVoxelSize(1. * mm);
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    G4double total = FillEvent(hce);
+    nexus::IonizationHitsCollection* hits = (nexus::IonizationHitsCollection*) hce.GetHC(HCID);
+    REQUIRE(hits->entries() == 100u);
+    REQUIRE(Sum(hits) == Approx(total));
+
+    // Every hit lies within its 1-mm voxel, at the centroid of the
+    // deposits of the voxel (so there is one hit per voxel)
+    std::map<G4long, G4int> voxel_hits;
+    for (size_t i=0; i<hits->entries(); ++i) {
+      G4ThreeVector position = (*hits)[i]->GetPosition();
+      G4long voxel = std::floor(position.z() / mm);
+      REQUIRE(voxel_sums.count(voxel) == 1);
+      REQUIRE(position.z() >= voxel * mm);
+      REQUIRE(position.z() <  (voxel + 1) * mm);
+      const std::pair<G4double, G4double>& sums = voxel_sums[voxel];
+      REQUIRE(position.z() == Approx(sums.second / sums.first));
+      REQUIRE((*hits)[i]->GetEnergyDeposit() == Approx(sums.first));
+      REQUIRE(++voxel_hits[voxel] == 1);
+    }
+  }
+
+  SECTION("Time window") {
+    // Prompt and delayed deposits in the same voxel are not merged
+    nexus::IonizationSD::SetMergeMode("event");
+    nexus::IonizationSD::SetVoxelSize(1. * mm);
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    sd->Initialize(&hce);
+    G4ThreeVector xyz(0.5 * mm, 0.5 * mm, 0.5 * mm);
+    sd->AddDeposit(1, xyz, 1. * ns, 10. * keV);
+    sd->AddDeposit(1, xyz, 2. * ns, 10. * keV);
+    sd->AddDeposit(2, xyz, 1. * second, 30. * keV);
+    sd->EndOfEvent(&hce);
+
+    nexus::IonizationHitsCollection* hits = (nexus::IonizationHitsCollection*) hce.GetHC(HCID);
+    REQUIRE(hits->entries() == 2u);
+    REQUIRE((*hits)[0]->GetEnergyDeposit() == Approx(20. * keV));
+    REQUIRE((*hits)[1]->GetEnergyDeposit() == Approx(30. * keV));
+    REQUIRE((*hits)[1]->GetTime() == Approx(1. * second));
+  }
+
+  SECTION("Very delayed deposits") {
+    // Times of long-lived decays are far beyond the range of an
+    // integer number of time windows
+    nexus::IonizationSD::SetMergeMode("event");
+    nexus::IonizationSD::SetVoxelSize(1. * mm);
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    sd->Initialize(&hce);
+    G4ThreeVector xyz(0.5 * mm, 0.5 * mm, 0.5 * mm);
+    sd->AddDeposit(1, xyz, 1. * ns, 10. * keV);
+    sd->AddDeposit(2, xyz, 1.e25 * ns, 20. * keV);
+    sd->AddDeposit(2, xyz, 1.e25 * ns, 20. * keV);
+    sd->AddDeposit(3, xyz, 2.e25 * ns, 30. * keV);
+    sd->EndOfEvent(&hce);
+
+    nexus::IonizationHitsCollection* hits = (nexus::IonizationHitsCollection*) hce.GetHC(HCID);
+    REQUIRE(hits->entries() == 3u);
+    REQUIRE((*hits)[0]->GetEnergyDeposit() == Approx(10. * keV));
+    REQUIRE((*hits)[1]->GetEnergyDeposit() == Approx(40. * keV));
+    REQUIRE((*hits)[1]->GetTime() == Approx(1.e25 * ns));
+    REQUIRE((*hits)[2]->GetEnergyDeposit() == Approx(30. * keV));
+    REQUIRE((*hits)[2]->GetTime() == Approx(2.e25 * ns));
+  }
+
+  nexus::IonizationSD::SetMergeMode("none");
+}
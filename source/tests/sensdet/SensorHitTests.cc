@@ -0,0 +1,59 @@
+#include <SensorHit.h>
+
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+#include <vector>
+#include <utility>
+
+
+TEST_CASE("SensorHit::Fill") {
+  // This test checks that the waveform window grows in both directions
+  // and that only the non-empty bins are iterated, in time order.
+
+  nexus::SensorHit hit(0, G4ThreeVector(), 1. * microsecond);
+  REQUIRE(hit.IsEmpty());
+  REQUIRE(!(hit.begin() != hit.end()));
+
+  hit.Fill(10.5 * microsecond);
+  hit.Fill(10.7 * microsecond, 2);
+  hit.Fill(15.2 * microsecond);
+  hit.Fill( 3.9 * microsecond);
+
+  REQUIRE(hit.GetFirstBin() ==  3);
+  REQUIRE(hit.GetLastBin()  == 15);
+  REQUIRE(hit.GetCounts(10) ==  3);
+  REQUIRE(hit.GetCounts(11) ==  0);
+  REQUIRE(hit.GetCounts(99) ==  0);
+
+  std::vector<std::pair<G4long, G4int>> bins(hit.begin(), hit.end());
+  std::vector<std::pair<G4long, G4int>> expected = {{3, 1}, {10, 3}, {15, 1}};
+  REQUIRE(bins == expected);
+}
+
+
+TEST_CASE("SensorHit sparse waveform") {
+  // This test checks that photons far apart in time (seconds, as in
+  // the decays of a long-lived isotope) only take the bins they fill.
+
+  nexus::SensorHit hit(0, G4ThreeVector(), 1. * microsecond);
+
+  hit.Fill(1. * microsecond);
+  hit.Fill(3. * second, 4);
+
+  REQUIRE(hit.GetFirstBin() == 1);
+  REQUIRE(hit.GetLastBin()  == 3000000);
+  REQUIRE(hit.GetCounts(1)       == 1);
+  REQUIRE(hit.GetCounts(3000000) == 4);
+  REQUIRE(hit.GetCounts(1500000) == 0);
+
+  std::vector<std::pair<G4long, G4int>> bins(hit.begin(), hit.end());
+  std::vector<std::pair<G4long, G4int>> expected = {{1, 1}, {3000000, 4}};
+  REQUIRE(bins == expected);
+
+  nexus::SensorHit copy(hit);
+  copy.Fill(3. * second);
+  REQUIRE(copy.GetCounts(3000000) == 5);
+  REQUIRE(hit.GetCounts(3000000)  == 4);
+}
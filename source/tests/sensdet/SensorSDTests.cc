@@ -0,0 +1,211 @@
+#include <SensorSD.h>
+#include <SensorRegistry.h>
+
+#include <G4SDManager.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <vector>
+
+
+namespace {
+
+  // Sensitive detectors can only be registered once in the SD manager
+  nexus::SensorSD* GetSensorSD()
+  {
+    static nexus::SensorSD* sd = nullptr;
+    if (!sd) {
+      sd = new nexus::SensorSD("/TEST/SENSOR_ARRAY");
+      sd->SetTimeBinning(1. * microsecond);
+      G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+    }
+    return sd;
+  }
+
+  // Locates in the SensorRegistry the sensors with ids 1000 to
+  // 1000 + nsensors - 1, placed (once) in a world volume
+  void BuildSensorRegistry(G4int nsensors)
+  {
+    static G4LogicalVolume* world_logic = nullptr;
+    static G4VPhysicalVolume* world = nullptr;
+    static G4LogicalVolume* sensor_logic = nullptr;
+    static G4int nplaced = 0;
+
+    if (!world) {
+      G4Material* vacuum =
+        G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+      G4Box* world_solid = new G4Box("SENSOR_WORLD", 10.*m, 10.*m, 10.*m);
+      world_logic = new G4LogicalVolume(world_solid, vacuum, "SENSOR_WORLD");
+      world = new G4PVPlacement(0, G4ThreeVector(), world_logic,
+                                "SENSOR_WORLD", 0, false, 0);
+
+      G4Box* sensor_solid = new G4Box("SENSOR", 0.5*mm, 0.5*mm, 0.5*mm);
+      sensor_logic = new G4LogicalVolume(sensor_solid, vacuum, "SENSOR");
+      sensor_logic->SetSensitiveDetector(GetSensorSD());
+      nexus::SensorRegistry::Instance().RegisterSensorVolume(sensor_logic);
+    }
+
+    for (; nplaced<nsensors; ++nplaced)
+      new G4PVPlacement(0, G4ThreeVector(2. * nplaced * mm, 0., 0.), sensor_logic,
+                        "SENSOR", world_logic, false, 1000 + nplaced);
+
+    nexus::SensorRegistry::Instance().Build(world);
+  }
+
+  // Synthetic stream of detected photons over a large array of sensors
+  // (of the size of the NEXT-100 tracking plane), as in an S2 signal
+  struct PhotonStream {
+    std::vector<G4int> ids;
+    std::vector<G4double> times;
+
+    PhotonStream(G4int nsensors, G4int nphotons)
+    {
+      ids.reserve(nphotons);
+      times.reserve(nphotons);
+      for (G4int i=0; i<nphotons; ++i) {
+        ids.push_back(1000 + (G4int)(nsensors * G4UniformRand()));
+        times.push_back(100. * microsecond * G4UniformRand());
+      }
+    }
+  };
+
+}
+
+
+TEST_CASE("SensorSD::RegisterPhoton") {
+  // This test checks that every sensor gets one hit containing
+  // all the photons it detected.
+
+  const G4int nsensors = 3500;
+  PhotonStream stream(nsensors, 100000);
+
+  nexus::SensorSD* sd = GetSensorSD();
+  G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+  sd->Initialize(&hce);
+
+  std::vector<G4int> counts(nsensors, 0);
+  for (size_t i=0; i<stream.ids.size(); ++i) {
+    sd->RegisterPhoton(stream.ids[i], G4ThreeVector(), stream.times[i]);
+    counts[stream.ids[i] - 1000]++;
+  }
+
+  G4int HCID = G4SDManager::GetSDMpointer()->
+    GetCollectionID("/TEST/SENSOR_ARRAY/" + nexus::SensorSD::GetCollectionUniqueName());
+  SensorHitsCollection* hits = (SensorHitsCollection*) hce.GetHC(HCID);
+
+  G4int nhit_sensors = 0;
+  for (G4int c: counts) if (c > 0) nhit_sensors++;
+  REQUIRE(hits->entries() == (size_t) nhit_sensors);
+
+  for (size_t i=0; i<hits->entries(); ++i) {
+    G4int total = 0;
+    for (auto bin: *(*hits)[i]) total += bin.second;
+    REQUIRE(total == counts[(*hits)[i]->GetPmtID() - 1000]);
+  }
+}
+
+
+TEST_CASE("SensorSD::RegisterPhoton with registered sensors") {
+  // This test checks that the sensors located by the SensorRegistry
+  // (whose hits are kept in a dense array) and those unknown to it
+  // (kept in a hash table) get the same hits in the same event
+
+  const G4int nregistered = 100;
+  const G4int nsensors = 300;
+
+  nexus::SensorSD* sd = GetSensorSD();
+  nexus::SensorRegistry& registry = nexus::SensorRegistry::Instance();
+  BuildSensorRegistry(nregistered);
+
+  REQUIRE(registry.GetNumberOfSensors() == nregistered);
+  for (G4int i=0; i<nregistered; ++i) {
+    G4int index = registry.GetIndex(1000 + i);
+    REQUIRE(index == i);
+    REQUIRE(registry.GetSensor(index).id == 1000 + i);
+    REQUIRE(registry.GetSensor(index).position.x() == Approx(2. * i * mm));
+  }
+  REQUIRE(registry.GetIndex(1000 + nregistered) == -1);
+
+  // Photons over the registered sensors and as many unknown ones
+  PhotonStream stream(nsensors, 100000);
+
+  G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+  sd->Initialize(&hce);
+
+  std::vector<G4int> counts(nsensors, 0);
+  for (size_t i=0; i<stream.ids.size(); ++i) {
+    sd->RegisterPhoton(stream.ids[i], G4ThreeVector(), stream.times[i]);
+    counts[stream.ids[i] - 1000]++;
+  }
+
+  G4int HCID = G4SDManager::GetSDMpointer()->
+    GetCollectionID("/TEST/SENSOR_ARRAY/" + nexus::SensorSD::GetCollectionUniqueName());
+  SensorHitsCollection* hits = (SensorHitsCollection*) hce.GetHC(HCID);
+
+  G4int nhit_sensors = 0;
+  for (G4int c: counts) if (c > 0) nhit_sensors++;
+  REQUIRE(hits->entries() == (size_t) nhit_sensors);
+
+  G4int registered_total = 0, unknown_total = 0;
+  for (size_t i=0; i<hits->entries(); ++i) {
+    G4int id = (*hits)[i]->GetPmtID();
+    G4int total = 0;
+    for (auto bin: *(*hits)[i]) total += bin.second;
+    REQUIRE(total == counts[id - 1000]);
+    if (id < 1000 + nregistered) registered_total += total;
+    else unknown_total += total;
+  }
+
+  G4int expected = 0;
+  for (G4int i=0; i<nregistered; ++i) expected += counts[i];
+  REQUIRE(registered_total == expected);
+  REQUIRE(registered_total + unknown_total == (G4int) stream.ids.size());
+
+  // A second event starts with no hits from the first one
+  G4HCofThisEvent hce2(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+  sd->Initialize(&hce2);
+  sd->RegisterPhoton(1000, G4ThreeVector(), 0.);
+  sd->RegisterPhoton(1000 + nsensors, G4ThreeVector(), 0.);
+  hits = (SensorHitsCollection*) hce2.GetHC(HCID);
+  REQUIRE(hits->entries() == 2u);
+  for (size_t i=0; i<hits->entries(); ++i) {
+    G4int total = 0;
+    for (auto bin: *(*hits)[i]) total += bin.second;
+    REQUIRE(total == 1);
+  }
+}
+
+
+TEST_CASE("SensorSD::RegisterPhoton benchmark", "[.][benchmark]") {
+
+  PhotonStream stream(3500, 1000000);
+  nexus::SensorSD* sd = GetSensorSD();
+
+  // Hits of sensors unknown to the registry (hash table), unless
+  // other tests have located them already
+  BENCHMARK("1M photons over 3500 sensors") {
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    sd->Initialize(&hce);
+    for (size_t i=0; i<stream.ids.size(); ++i)
+      sd->RegisterPhoton(stream.ids[i], G4ThreeVector(), stream.times[i]);
+    return hce.GetNumberOfCollections();
+  };
+
+  // Hits of sensors located by the registry (dense array)
+  BuildSensorRegistry(3500);
+
+  BENCHMARK("1M photons over 3500 registered sensors") {
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    sd->Initialize(&hce);
+    for (size_t i=0; i<stream.ids.size(); ++i)
+      sd->RegisterPhoton(stream.ids[i], G4ThreeVector(), stream.times[i]);
+    return hce.GetNumberOfCollections();
+  };
+}
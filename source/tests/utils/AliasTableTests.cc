@@ -0,0 +1,28 @@
+#include <AliasTable.h>
+
+#include <catch.hpp>
+
+#include <vector>
+
+
+TEST_CASE("Alias table") {
+
+  // This test checks that the outcomes of the alias table
+  // follow the given weights
+
+  std::vector<G4double> weights = {1., 0., 3., 0.5, 5.5};
+  nexus::AliasTable table(weights);
+
+  REQUIRE(table.GetSize() == weights.size());
+  REQUIRE(table.GetTotalWeight() == Approx(10.));
+
+  // Sample on a fine regular grid of random numbers, so that
+  // the frequencies are exact up to the grid spacing
+  const G4int n = 1000000;
+  std::vector<G4int> counts(weights.size(), 0);
+  for (G4int i=0; i<n; i++)
+    counts[table.Sample((i + 0.5) / n)]++;
+
+  for (size_t i=0; i<weights.size(); i++)
+    REQUIRE(counts[i] / G4double(n) == Approx(weights[i] / 10.).margin(1.e-4));
+}
@@ -0,0 +1,74 @@
+#include <DenseIdMap.h>
+
+#include <catch.hpp>
+
+#include <map>
+#include <vector>
+
+
+TEST_CASE("Dense id map") {
+
+  // This test checks that the map behaves as an associative
+  // container indexed by id, also after being cleared
+
+  std::vector<G4int> objects = {10, 20, 30};
+  nexus::DenseIdMap<G4int> map;
+
+  REQUIRE(map.Get(0) == nullptr);
+  REQUIRE(map.Get(-1) == nullptr);
+
+  map.Add(5, &objects[0]);
+  map.Add(1, &objects[1]);
+  REQUIRE(map.Get(5) == &objects[0]);
+  REQUIRE(map.Get(1) == &objects[1]);
+  REQUIRE(map.Get(3) == nullptr);
+  REQUIRE(map.Get(6) == nullptr);
+
+  map.Add(5, &objects[2]);
+  REQUIRE(map.Get(5) == &objects[2]);
+
+  map.Clear();
+  REQUIRE(map.Get(5) == nullptr);
+  REQUIRE(map.Get(1) == nullptr);
+
+  map.Add(2, &objects[0]);
+  REQUIRE(map.Get(2) == &objects[0]);
+  REQUIRE(map.Get(5) == nullptr);
+}
+
+
+TEST_CASE("Dense id map benchmark", "[.][benchmark]") {
+  // Mimic the trajectory bookkeeping of a high-multiplicity event
+  // (e.g. a muon shower): every new track looks up the trajectory
+  // of its parent and adds its own one.
+
+  const G4int ntracks = 200000;
+  std::vector<G4int> objects(ntracks + 1);
+  std::vector<G4int> parents(ntracks + 1, 0);
+  unsigned int seed = 12345;
+  for (G4int id=2; id<=ntracks; id++) {
+    seed = 1664525u * seed + 1013904223u;
+    parents[id] = 1 + seed % (id - 1);
+  }
+
+  BENCHMARK("std::map") {
+    std::map<G4int, G4int*> map;
+    size_t found = 0;
+    for (G4int id=1; id<=ntracks; id++) {
+      found += map.count(parents[id]);
+      map[id] = &objects[id];
+    }
+    return found;
+  };
+
+  nexus::DenseIdMap<G4int> dense;
+  BENCHMARK("nexus::DenseIdMap") {
+    dense.Clear();
+    size_t found = 0;
+    for (G4int id=1; id<=ntracks; id++) {
+      found += (dense.Get(parents[id]) != nullptr);
+      dense.Add(id, &objects[id]);
+    }
+    return found;
+  };
+}
@@ -0,0 +1,26 @@
+#include <Philox.h>
+
+#include <catch.hpp>
+
+
+TEST_CASE("Philox known answers") {
+
+  // This test checks the generator against the known-answer
+  // vectors of the reference implementation (Random123)
+
+  nexus::PhiloxCounter zeros = nexus::Philox4x32({0, 0, 0, 0}, {0, 0});
+  REQUIRE(zeros == nexus::PhiloxCounter{0x6627e8d5, 0xe169c58d,
+                                        0xbc57ac4c, 0x9b00dbd8});
+
+  nexus::PhiloxCounter ones =
+    nexus::Philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                      {0xffffffff, 0xffffffff});
+  REQUIRE(ones == nexus::PhiloxCounter{0x408f276d, 0x41c83b0e,
+                                       0xa20bc7c6, 0x6d5451fd});
+
+  nexus::PhiloxCounter pi =
+    nexus::Philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                      {0xa4093822, 0x299f31d0});
+  REQUIRE(pi == nexus::PhiloxCounter{0xd16cfe09, 0x94fdcceb,
+                                     0x5001e420, 0x24126ea1});
+}
@@ -4,6 +4,7 @@
 
 #include <catch.hpp>
 #include <iostream>
+#include <vector>
 #include <cmath>
 using namespace std;
 
@@ -41,3 +42,33 @@ TEST_CASE("Direction Function") {
   }
 
 }
+
+
+TEST_CASE("Gaussian batch") {
+
+  // This test checks that the counter-based generator gives the same
+  // numbers for the same key and counter, whatever the batch, and that
+  // they are distributed as a standard normal.
+
+  const size_t n = 100000;
+  std::vector<G4double> normals(n);
+  nexus::GaussianRandomBatch(12345, 0, normals.data(), n);
+
+  std::vector<G4double> tail(10);
+  nexus::GaussianRandomBatch(12345, 500, tail.data(), tail.size());
+  for (size_t i=0; i<tail.size(); i++)
+    REQUIRE(tail[i] == normals[1000+i]);
+
+  std::vector<G4double> other(10);
+  nexus::GaussianRandomBatch(54321, 0, other.data(), other.size());
+  REQUIRE(other[0] != normals[0]);
+
+  G4double mean = 0., var = 0.;
+  for (auto x: normals) mean += x;
+  mean /= n;
+  for (auto x: normals) var += (x - mean) * (x - mean);
+  var /= n;
+
+  REQUIRE(std::abs(mean) < 0.02);
+  REQUIRE(std::abs(var - 1.) < 0.02);
+}
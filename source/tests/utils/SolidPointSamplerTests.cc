@@ -0,0 +1,80 @@
+#include <SolidPointSampler.h>
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4UnionSolid.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+
+TEST_CASE("SolidPointSampler") {
+
+  // This test checks that the points are generated inside the solid, that
+  // three equal boxes aligned with the apex of the tessellation (so that
+  // their tetrahedra overlap) are sampled with the same frequency and that
+  // curved solids are sampled uniformly up to their actual surface
+
+  SECTION("Tube") {
+    G4Tubs tube("TUBE", 10.*mm, 20.*mm, 30.*mm, 0., twopi);
+    nexus::SolidPointSampler sampler(&tube);
+
+    for (G4int i=0; i<1000; i++) {
+      auto vertex = sampler.GenerateVertex("VOLUME");
+      REQUIRE(tube.Inside(vertex) != kOutside);
+    }
+  }
+
+  SECTION("Tube uniformity") {
+    // The tessellation of the tube (24 sides) is up to 0.17 mm inside
+    // its surface: the shell of the last 0.2 mm must not be depleted
+    const G4double rmax = 20.*mm;
+    const G4double shell = 0.2*mm;
+    G4Tubs tube("TUBE", 0., rmax, 10.*mm, 0., twopi);
+    nexus::SolidPointSampler sampler(&tube);
+
+    const G4int n = 200000;
+    G4int in_shell = 0;
+    G4int in_core  = 0;
+    for (G4int i=0; i<n; i++) {
+      auto vertex = sampler.GenerateVertex("VOLUME");
+      REQUIRE(tube.Inside(vertex) != kOutside);
+      if (vertex.perp() > rmax - shell) in_shell++;
+      if (vertex.perp() < rmax / 2.) in_core++;
+    }
+
+    G4double expected = 1. - std::pow((rmax - shell) / rmax, 2);
+    G4double sigma = std::sqrt(expected * (1. - expected) / n);
+    REQUIRE(std::abs(in_shell / G4double(n) - expected) < 5. * sigma);
+    REQUIRE(in_core / G4double(n) == Approx(0.25).margin(0.005));
+
+    // Surface points are projected onto the actual surface
+    for (G4int i=0; i<1000; i++) {
+      auto vertex = sampler.GenerateVertex("SURFACE");
+      REQUIRE(tube.Inside(vertex) == kSurface);
+    }
+  }
+
+  SECTION("Union") {
+    G4Box box("BOX", 10.*mm, 10.*mm, 10.*mm);
+    G4UnionSolid two("TWO", &box, &box, nullptr, G4ThreeVector(100.*mm, 0., 0.));
+    G4UnionSolid three("THREE", &two, &box, nullptr, G4ThreeVector(200.*mm, 0., 0.));
+    nexus::SolidPointSampler sampler(&three);
+
+    REQUIRE(sampler.GetVolume() == Approx(3 * box.GetCubicVolume()));
+
+    const G4int n = 30000;
+    G4int counts[3] = {0, 0, 0};
+    for (G4int i=0; i<n; i++) {
+      auto vertex = sampler.GenerateVertex("VOLUME");
+      REQUIRE(three.Inside(vertex) != kOutside);
+      counts[std::lround(vertex.x() / (100.*mm))]++;
+    }
+
+    for (G4int k=0; k<3; k++)
+      REQUIRE(counts[k] / G4double(n) == Approx(1./3.).margin(0.02));
+  }
+}
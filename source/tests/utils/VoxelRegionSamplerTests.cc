@@ -0,0 +1,91 @@
+#include <VoxelRegionSampler.h>
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4GeometryManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+
+TEST_CASE("VoxelRegionSampler") {
+
+  // This test checks that the points are generated uniformly in a region
+  // made of a tube and a disk much thinner than the voxels, comparing the
+  // fraction of points in the disk with the plain rejection sampling of
+  // the enclosing shell (and with the ratio of volumes)
+
+  G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+
+  G4Box* world_solid = new G4Box("VRS_WORLD", 1.*m, 1.*m, 1.*m);
+  G4LogicalVolume* world_logic = new G4LogicalVolume(world_solid, vacuum, "VRS_WORLD");
+  G4VPhysicalVolume* world =
+    new G4PVPlacement(0, G4ThreeVector(), world_logic, "VRS_WORLD", 0, false, 0);
+
+  G4Tubs* tube_solid = new G4Tubs("VRS_TUBE", 10.*mm, 20.*mm, 50.*mm, 0., twopi);
+  G4LogicalVolume* tube_logic = new G4LogicalVolume(tube_solid, vacuum, "VRS_TUBE");
+  new G4PVPlacement(0, G4ThreeVector(), tube_logic, "VRS_TUBE", world_logic, false, 0);
+
+  G4Tubs* disk_solid = new G4Tubs("VRS_DISK", 0., 20.*mm, 0.1*mm, 0., twopi);
+  G4LogicalVolume* disk_logic = new G4LogicalVolume(disk_solid, vacuum, "VRS_DISK");
+  new G4PVPlacement(0, G4ThreeVector(0., 0., 60.*mm), disk_logic, "VRS_DISK",
+                    world_logic, false, 0);
+
+  G4GeometryManager::GetInstance()->CloseGeometry();
+  G4Navigator* navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  G4VPhysicalVolume* previous_world = navigator->GetWorldVolume();
+  navigator->SetWorldVolume(world);
+
+  const G4double min_rad = 0., max_rad = 25.*mm, half_length = 70.*mm;
+  nexus::VoxelRegionSampler sampler(min_rad, max_rad, half_length,
+                                    G4ThreeVector(), G4ThreeVector(),
+                                    {"VRS_TUBE", "VRS_DISK"}, 2000);
+
+  G4double tube_volume = tube_solid->GetCubicVolume();
+  G4double disk_volume = disk_solid->GetCubicVolume();
+  G4double expected = disk_volume / (tube_volume + disk_volume);
+
+  const G4int n = 100000;
+  G4double sigma = std::sqrt(expected * (1. - expected) / n);
+
+  // Voxel sampling
+  G4int in_disk = 0;
+  for (G4int i=0; i<n; i++) {
+    G4ThreeVector point = sampler.GenerateVertex();
+    G4VPhysicalVolume* volume =
+      navigator->LocateGlobalPointAndSetup(point, 0, false);
+    REQUIRE(volume);
+    REQUIRE((volume->GetName() == "VRS_TUBE" || volume->GetName() == "VRS_DISK"));
+    if (volume->GetName() == "VRS_DISK") in_disk++;
+  }
+
+  // Plain rejection sampling of the enclosing shell
+  G4int ref_in_disk = 0;
+  for (G4int i=0; i<n; ) {
+    G4double r = std::sqrt(min_rad*min_rad +
+                           G4UniformRand() * (max_rad*max_rad - min_rad*min_rad));
+    G4double phi = twopi * G4UniformRand();
+    G4double z = half_length * (2. * G4UniformRand() - 1.);
+    G4VPhysicalVolume* volume = navigator->LocateGlobalPointAndSetup
+      (G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z), 0, false);
+    if (volume->GetName() == "VRS_DISK") ref_in_disk++;
+    if (volume->GetName() == "VRS_DISK" || volume->GetName() == "VRS_TUBE") i++;
+  }
+
+  REQUIRE(std::abs((G4double) in_disk / n - expected) < 5. * sigma);
+  REQUIRE(std::abs((G4double) ref_in_disk / n - expected) < 5. * sigma);
+  REQUIRE(std::abs((G4double) (in_disk - ref_in_disk) / n) < 5. * std::sqrt(2.) * sigma);
+
+  if (previous_world) navigator->SetWorldVolume(previous_world);
+  G4GeometryManager::GetInstance()->OpenGeometry();
+}
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// nexus | AliasTable.cc
+//
+// This class samples in constant time a discrete distribution given by
+// a set of (non-normalized) weights, using Walker's alias method.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "AliasTable.h"
+
+#include <Randomize.hh>
+
+
+namespace nexus {
+
+
+  AliasTable::AliasTable(): total_weight_(0.)
+  {
+  }
+
+
+
+  AliasTable::AliasTable(const std::vector<G4double>& weights):
+    total_weight_(0.)
+  {
+    SetWeights(weights);
+  }
+
+
+
+  AliasTable::~AliasTable()
+  {
+  }
+
+
+
+  void AliasTable::SetWeights(const std::vector<G4double>& weights)
+  {
+    const size_t n = weights.size();
+
+    total_weight_ = 0.;
+    for (G4double w: weights) {
+      if (w < 0.) {
+        G4Exception("[AliasTable]", "SetWeights()", FatalException,
+                    "Negative weight.");
+      }
+      total_weight_ += w;
+    }
+
+    if (n == 0 || total_weight_ <= 0.) {
+      G4Exception("[AliasTable]", "SetWeights()", FatalException,
+                  "The weights must have a positive sum.");
+    }
+
+    prob_.assign(n, 1.);
+    alias_.resize(n);
+
+    // Vose's algorithm: bins with less than the average weight are
+    // completed with the excess of the bins with more than it
+    std::vector<G4double> scaled(n);
+    std::vector<size_t> small, large;
+    for (size_t i=0; i<n; i++) {
+      alias_[i] = i;
+      scaled[i] = weights[i] * n / total_weight_;
+      if (scaled[i] < 1.) small.push_back(i);
+      else large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+      size_t s = small.back(); small.pop_back();
+      size_t l = large.back();
+
+      prob_[s] = scaled[s];
+      alias_[s] = l;
+
+      scaled[l] -= 1. - scaled[s];
+      if (scaled[l] < 1.) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Whatever is left is full up to rounding errors
+    for (size_t i: small) prob_[i] = 1.;
+    for (size_t i: large) prob_[i] = 1.;
+  }
+
+
+
+  size_t AliasTable::Shoot() const
+  {
+    return Sample(G4UniformRand());
+  }
+
+
+} // end namespace nexus
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// nexus | AliasTable.h
+//
+// This class samples in constant time a discrete distribution given by
+// a set of (non-normalized) weights, using Walker's alias method.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <globals.hh>
+
+#include <vector>
+
+
+namespace nexus {
+
+  class AliasTable
+  {
+  public:
+    /// Default constructor (empty table)
+    AliasTable();
+    /// Constructor providing the weights of the outcomes
+    AliasTable(const std::vector<G4double>& weights);
+    /// Destructor
+    ~AliasTable();
+
+    /// Set the weights of the outcomes
+    void SetWeights(const std::vector<G4double>& weights);
+
+    /// Return an outcome, given a uniform random number in [0, 1)
+    size_t Sample(G4double u) const;
+
+    /// Return an outcome, drawing the random number from the Geant4 engine
+    size_t Shoot() const;
+
+    /// Return the number of outcomes
+    size_t GetSize() const;
+    /// Return the sum of the weights
+    G4double GetTotalWeight() const;
+
+  private:
+    std::vector<G4double> prob_; ///< Probability of keeping every outcome
+    std::vector<G4int> alias_;   ///< Alternative outcome of every bin
+    G4double total_weight_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline size_t AliasTable::Sample(G4double u) const
+  {
+    // The integer part of u*n selects the bin,
+    // the fractional part the outcome within it
+    G4double x = u * prob_.size();
+    size_t i = x;
+    if (i >= prob_.size()) i = prob_.size() - 1;
+    return (x - i < prob_[i]) ? i : alias_[i];
+  }
+
+  inline size_t AliasTable::GetSize() const
+  { return prob_.size(); }
+
+  inline G4double AliasTable::GetTotalWeight() const
+  { return total_weight_; }
+
+} // end namespace nexus
+
+#endif
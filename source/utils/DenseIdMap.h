@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// nexus | DenseIdMap.h
+//
+// This class is an associative container for objects identified by small,
+// dense, non-negative integer ids (such as the track ids of an event).
+// Objects are stored in a vector indexed by id, so that every lookup is a
+// single indexed load.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef DENSE_ID_MAP_H
+#define DENSE_ID_MAP_H
+
+#include <globals.hh>
+
+#include <vector>
+
+
+namespace nexus {
+
+  template <class T>
+  class DenseIdMap
+  {
+  public:
+    /// Return the object with the given id (null if there is none)
+    T* Get(G4int id) const;
+    /// Add an object with the given id, replacing the previous one if any
+    void Add(G4int id, T* object);
+    /// Remove all the objects (keeping the memory allocated)
+    void Clear();
+
+  private:
+    std::vector<T*> objects_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  template <class T>
+  inline T* DenseIdMap<T>::Get(G4int id) const
+  {
+    return (id >= 0 && size_t(id) < objects_.size()) ? objects_[id] : 0;
+  }
+
+  template <class T>
+  inline void DenseIdMap<T>::Add(G4int id, T* object)
+  {
+    if (id < 0) {
+      G4Exception("[DenseIdMap]", "Add()", FatalException,
+                  "Ids must be non-negative.");
+    }
+    if (size_t(id) >= objects_.size()) objects_.resize(id+1, 0);
+    objects_[id] = object;
+  }
+
+  template <class T>
+  inline void DenseIdMap<T>::Clear()
+  {
+    objects_.clear();
+  }
+
+} // end namespace nexus
+
+#endif
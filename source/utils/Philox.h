@@ -0,0 +1,53 @@
+// ----------------------------------------------------------------------------
+// nexus | Philox.h
+//
+// Philox4x32-10 counter-based random number generator (J. Salmon et al.,
+// "Parallel random numbers: as easy as 1, 2, 3", SC'11). It maps a counter
+// and a key to four random words without any internal state, so the same
+// (counter, key) pair always gives the same numbers, whatever the order
+// in which they are requested.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+
+namespace nexus {
+
+  typedef std::array<std::uint32_t, 4> PhiloxCounter;
+  typedef std::array<std::uint32_t, 2> PhiloxKey;
+
+  /// Return the four random words of the given counter and key
+  PhiloxCounter Philox4x32(PhiloxCounter counter, PhiloxKey key);
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline PhiloxCounter Philox4x32(PhiloxCounter ctr, PhiloxKey key)
+  {
+    const std::uint64_t M0 = 0xD2511F53;
+    const std::uint64_t M1 = 0xCD9E8D57;
+    const std::uint32_t W0 = 0x9E3779B9;
+    const std::uint32_t W1 = 0xBB67AE85;
+
+    for (int round=0; round<10; round++) {
+      std::uint64_t p0 = M0 * ctr[0];
+      std::uint64_t p1 = M1 * ctr[2];
+
+      ctr = {std::uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], std::uint32_t(p1),
+             std::uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], std::uint32_t(p0)};
+
+      key[0] += W0;
+      key[1] += W1;
+    }
+
+    return ctr;
+  }
+
+} // end namespace nexus
+
+#endif
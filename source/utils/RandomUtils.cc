@@ -6,10 +6,27 @@
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 #include "RandomUtils.h"
+#include "Philox.h"
 
 #include <Randomize.hh>
 
 #include "CLHEP/Units/SystemOfUnits.h"
+#include "CLHEP/Units/PhysicalConstants.h"
+
+#include <cmath>
+
+
+namespace {
+
+  // Uniform number in the open interval (0, 1) from 64 random bits
+  inline G4double ToUniform(uint32_t hi, uint32_t lo)
+  {
+    uint64_t bits = (uint64_t(hi) << 32) | lo;
+    return ((bits >> 11) + 0.5) * (1. / 9007199254740992.); // 2^-53
+  }
+
+}
+
 
 namespace nexus {
 
@@ -39,4 +56,32 @@ namespace nexus {
   }
 
 
+  void GaussianRandomBatch(uint64_t key, uint64_t counter,
+                           G4double* normals, size_t n)
+  {
+    const PhiloxKey philox_key = {uint32_t(key), uint32_t(key >> 32)};
+
+    for (size_t i=0; i<n; i+=2) {
+      uint64_t c = counter + i/2;
+      PhiloxCounter ctr =
+        Philox4x32({uint32_t(c), uint32_t(c >> 32), 0, 0}, philox_key);
+
+      G4double r = std::sqrt(-2. * std::log(ToUniform(ctr[0], ctr[1])));
+      G4double phi = CLHEP::twopi * ToUniform(ctr[2], ctr[3]);
+
+      normals[i] = r * std::cos(phi);
+      if (i+1 < n) normals[i+1] = r * std::sin(phi);
+    }
+  }
+
+
+  uint64_t RandomKey()
+  {
+    CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+    uint64_t hi = static_cast<unsigned int>(*engine);
+    uint64_t lo = static_cast<unsigned int>(*engine);
+    return (hi << 32) | lo;
+  }
+
+
 }
@@ -8,6 +8,9 @@
 
 #include <G4ThreeVector.hh>
 
+#include <cstdint>
+#include <cstddef>
+
 
 #ifndef RAND_U_H
 #define RAND_U_H
@@ -19,6 +22,18 @@ namespace nexus {
   G4ThreeVector RandomDirectionInRange(G4double costheta_min, G4double costheta_max,
                                        G4double phi_min, G4double phi_max);
 
+  /// Fills an array with n standard normal numbers generated with the
+  /// Box-Muller method from the counter-based generator Philox4x32-10.
+  /// The numbers depend only on the key and the counter, so that the
+  /// same values are obtained regardless of the order of the calls
+  /// (the i-th pair of numbers comes from counter + i).
+  void GaussianRandomBatch(uint64_t key, uint64_t counter,
+                           G4double* normals, size_t n);
+
+  /// Returns a 64-bit key for the counter-based generator drawn
+  /// from the Geant4 random engine
+  uint64_t RandomKey();
+
 }
 
 #endif
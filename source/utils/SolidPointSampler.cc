@@ -0,0 +1,384 @@
+// ----------------------------------------------------------------------------
+// nexus | SolidPointSampler.cc
+//
+// This class is a sampler of random uniform points in the volume or on the
+// surface of any Geant4 solid, including boolean solids and multi-unions.
+// The solid is tessellated once (via G4VSolid::GetPolyhedron) into
+// tetrahedra sharing a common apex and into surface triangles, and every
+// point is drawn from one of them chosen with an alias table. Since the
+// tessellation of curved surfaces is inscribed in them, the tetrahedra are
+// enlarged to enclose the solid (the points outside it being rejected) and
+// the surface points are projected onto the actual surface.
+//
+// Limitations:
+// - Surface points are uniform on the facets, not on the curved surface:
+//   their projection stretches them by up to the ratio between the areas
+//   of the surface and of the facet (1 + O(sagitta / radius)), which
+//   depends on the number of rotation steps of the polyhedra.
+// - Volume points of solids not star-shaped from the centre of their
+//   bounding box (e.g. hollow or boolean solids) are checked against
+//   every tetrahedron that may overlap theirs, so a draw costs O(k),
+//   k being the number of such tetrahedra, instead of O(1).
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SolidPointSampler.h"
+
+#include <G4VSolid.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Polyhedron.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+
+namespace nexus {
+
+
+  SolidPointSampler::SolidPointSampler(const G4VSolid* solid,
+                                       G4ThreeVector origin,
+                                       G4RotationMatrix* rotation):
+    solid_(solid), volume_(0.), max_projection_(0.),
+    origin_(origin), rotation_(rotation)
+  {
+    Build();
+  }
+
+
+
+  SolidPointSampler::SolidPointSampler(const G4LogicalVolume* logic,
+                                       G4ThreeVector origin,
+                                       G4RotationMatrix* rotation):
+    solid_(logic->GetSolid()), volume_(0.), max_projection_(0.),
+    origin_(origin), rotation_(rotation)
+  {
+    Build();
+  }
+
+
+
+  SolidPointSampler::~SolidPointSampler()
+  {
+  }
+
+
+
+  void SolidPointSampler::Build()
+  {
+    G4Polyhedron* polyhedron = solid_ ? solid_->GetPolyhedron() : nullptr;
+    if (!polyhedron || polyhedron->GetNoFacets() == 0) {
+      G4Exception("[SolidPointSampler]", "Build()", FatalException,
+                  "The solid cannot be tessellated.");
+    }
+
+    std::vector<G4ThreeVector> vertices;
+    for (G4int i=1; i<=polyhedron->GetNoVertices(); i++) {
+      G4Point3D v = polyhedron->GetVertex(i);
+      vertices.push_back(G4ThreeVector(v.x(), v.y(), v.z()));
+    }
+
+    // Facets are triangles or quadrilaterals, oriented outwards
+    std::vector<std::vector<G4int>> facets;
+    G4int nodes[4];
+    for (G4int i=1; i<=polyhedron->GetNoFacets(); i++) {
+      G4int n;
+      polyhedron->GetFacet(i, n, nodes);
+      for (G4int k=2; k<n; k++)
+        facets.push_back({nodes[0]-1, nodes[k-1]-1, nodes[k]-1});
+    }
+
+    // The apex is the centre of the bounding box of the tessellation
+    G4ThreeVector pmin = vertices[0], pmax = vertices[0];
+    for (const G4ThreeVector& p: vertices) {
+      pmin = G4ThreeVector(std::min(pmin.x(), p.x()), std::min(pmin.y(), p.y()),
+                           std::min(pmin.z(), p.z()));
+      pmax = G4ThreeVector(std::max(pmax.x(), p.x()), std::max(pmax.y(), p.y()),
+                           std::max(pmax.z(), p.z()));
+    }
+    apex_ = 0.5 * (pmin + pmax);
+
+    // The surface is sampled on the facets of the tessellation
+    std::vector<G4double> areas;
+    for (const std::vector<G4int>& f: facets) {
+      Triangle t = {vertices[f[0]], vertices[f[1]], vertices[f[2]]};
+      G4ThreeVector normal = (t.b - t.a).cross(t.c - t.a);
+      if (normal.mag() <= 0.) continue;
+      facets_.push_back(t);
+      normals_.push_back(normal.unit());
+      areas.push_back(0.5 * normal.mag());
+      volume_ += SignedVolume(t) / 6.;
+    }
+    facets_table_.SetWeights(areas);
+
+    // The vertices are moved outwards, so that every facet around them
+    // moves twice as far as it is from the surface it approximates and
+    // the tessellation encloses the solid. Vertices at the same position
+    // (in different pieces of the polyhedron) must move together, or the
+    // tessellation would crack.
+    G4double sagitta = GetMaxSagitta(vertices, facets);
+    max_projection_ = 2. * sagitta;
+    if (sagitta > 0.) {
+      G4double quantum = 1.e-9 * (pmax - pmin).mag();
+      auto Key = [quantum](const G4ThreeVector& p) {
+        return std::make_tuple(std::llround(p.x() / quantum),
+                               std::llround(p.y() / quantum),
+                               std::llround(p.z() / quantum));
+      };
+
+      // Distinct normals of the facets around every vertex
+      std::map<std::tuple<long long, long long, long long>,
+               std::vector<G4ThreeVector>> normals;
+      for (const std::vector<G4int>& f: facets) {
+        const G4ThreeVector& a = vertices[f[0]];
+        G4ThreeVector normal = (vertices[f[1]] - a).cross(vertices[f[2]] - a);
+        if (normal.mag() <= 0.) continue;
+        normal = normal.unit();
+        for (G4int k: f) {
+          std::vector<G4ThreeVector>& around = normals[Key(vertices[k])];
+          G4bool known = false;
+          for (const G4ThreeVector& n: around)
+            if (n.dot(normal) > 1. - 1.e-9) { known = true; break; }
+          if (!known) around.push_back(normal);
+        }
+      }
+
+      // The mean normal is stretched so that its projection on the
+      // normal of every facet is at least one (up to a limit, for
+      // very sharp edges)
+      for (G4ThreeVector& v: vertices) {
+        const std::vector<G4ThreeVector>& around = normals[Key(v)];
+        G4ThreeVector mean;
+        for (const G4ThreeVector& n: around) mean += n;
+        if (mean.mag() <= 0.) continue;
+        mean = mean.unit();
+        G4double projection = 1.;
+        for (const G4ThreeVector& n: around)
+          projection = std::min(projection, mean.dot(n));
+        v += 2. * sagitta / std::max(projection, 0.2) * mean;
+      }
+    }
+
+    for (const std::vector<G4int>& f: facets) {
+      Triangle t = {vertices[f[0]], vertices[f[1]], vertices[f[2]]};
+      if ((t.b - t.a).cross(t.c - t.a).mag() <= 0.) continue;
+      triangles_.push_back(t);
+    }
+
+    // The tetrahedra formed by the apex and the facets facing away from it
+    // count positively and the rest negatively, so that every point is
+    // covered by as many more positive than negative tetrahedra as its
+    // winding number: one inside the solid, zero outside. Points are drawn
+    // in the positive ones only and, where several of them overlap (when
+    // the solid is not star-shaped from the apex), accepted with the inverse
+    // of the coverage, so that the density is uniform.
+    const size_t ntri = triangles_.size();
+    std::vector<G4double> volumes(ntri, 0.);
+    std::vector<G4ThreeVector> axes(ntri);
+    std::vector<G4double> apertures(ntri, 0.);
+    G4double total = 0.;
+    sign_.assign(ntri, 0);
+    G4double tolerance = 1.e-12 * (pmax - pmin).mag2() * (pmax - pmin).mag();
+
+    for (size_t i=0; i<ntri; i++) {
+      const Triangle& t = triangles_[i];
+      G4double v = SignedVolume(t);
+      if (std::abs(v) <= tolerance) continue;
+      sign_[i] = (v > 0.) ? 1 : -1;
+      if (v > 0.) volumes[i] = v / 6.;
+      total += volumes[i];
+
+      // Cone from the apex enclosing the tetrahedron
+      axes[i] = ((t.a + t.b + t.c) / 3. - apex_).unit();
+      for (const G4ThreeVector* p: {&t.a, &t.b, &t.c})
+        apertures[i] = std::max(apertures[i], axes[i].angle(*p - apex_));
+    }
+
+    if (volume_ <= 0. || total <= 0.) {
+      G4Exception("[SolidPointSampler]", "Build()", FatalException,
+                  "The tessellation of the solid has no volume.");
+    }
+    tetrahedra_table_.SetWeights(volumes);
+
+    // Two tetrahedra sharing the apex can only overlap if their cones do
+    overlaps_.assign(ntri, {});
+    for (size_t i=0; i<ntri; i++) {
+      if (sign_[i] <= 0) continue;
+      for (size_t j=0; j<ntri; j++) {
+        if (j == i || sign_[j] == 0) continue;
+        if (axes[i].angle(axes[j]) < apertures[i] + apertures[j])
+          overlaps_[i].push_back(j);
+      }
+    }
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::GenerateVertex(const G4String& region) const
+  {
+    G4ThreeVector point;
+
+    if (region == "VOLUME") {
+      point = SampleVolume();
+    }
+    else if (region == "SURFACE") {
+      point = SampleSurface();
+    }
+    else {
+      G4Exception("[SolidPointSampler]", "GenerateVertex()", FatalException,
+                  "Unknown vertex generation region!");
+    }
+
+    return RotateAndTranslate(point);
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::SampleVolume() const
+  {
+    while (true) {
+      size_t i = tetrahedra_table_.Shoot();
+      const Triangle& t = triangles_[i];
+
+      // Uniform point in the tetrahedron, folding the unit cube into it
+      G4double s = G4UniformRand();
+      G4double u = G4UniformRand();
+      G4double w = G4UniformRand();
+      if (s + u > 1.) { s = 1. - s; u = 1. - u; }
+      if (u + w > 1.) {
+        G4double tmp = w;
+        w = 1. - s - u;
+        u = 1. - tmp;
+      }
+      else if (s + u + w > 1.) {
+        G4double tmp = w;
+        w = s + u + w - 1.;
+        s = 1. - u - tmp;
+      }
+      G4ThreeVector p = apex_ + s * (t.a - apex_) + u * (t.b - apex_)
+                              + w * (t.c - apex_);
+
+      G4int winding  = 1;
+      G4int coverage = 1;
+      for (size_t j: overlaps_[i]) {
+        if (!InTetrahedron(triangles_[j], p)) continue;
+        winding += sign_[j];
+        if (sign_[j] > 0) coverage++;
+      }
+
+      if (winding <= 0) continue;
+      if (coverage > 1 && G4UniformRand() * coverage >= 1.) continue;
+
+      // The tessellation of curved surfaces is only approximate
+      if (solid_->Inside(p) == kOutside) continue;
+
+      return p;
+    }
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::SampleSurface() const
+  {
+    // The facets of curved surfaces are only close to them, and the
+    // points with no surface nearby (as those of flat facets bordering a
+    // concave surface) are drawn again, up to a limit
+    G4ThreeVector p;
+    for (G4int attempt=0; attempt<max_attempts_; attempt++) {
+      size_t i = facets_table_.Shoot();
+      const Triangle& t = facets_[i];
+
+      G4double r = std::sqrt(G4UniformRand());
+      G4double u = G4UniformRand();
+      p = (1. - r) * t.a + r * (1. - u) * t.b + r * u * t.c;
+      p = ProjectOnSurface(p, normals_[i]);
+      if (solid_->Inside(p) == kSurface) break;
+    }
+    return p;
+  }
+
+
+
+  G4double SolidPointSampler::GetMaxSagitta
+  (const std::vector<G4ThreeVector>& vertices,
+   const std::vector<std::vector<G4int>>& facets) const
+  {
+    // The distance from the centre of every facet to the surface, along
+    // its normal, is that of its whole plane (to first order). Distances
+    // longer than the facet itself are to some other surface.
+    G4double sagitta = 0.;
+    for (const std::vector<G4int>& f: facets) {
+      const G4ThreeVector& a = vertices[f[0]];
+      const G4ThreeVector& b = vertices[f[1]];
+      const G4ThreeVector& c = vertices[f[2]];
+      G4ThreeVector normal = (b - a).cross(c - a);
+      if (normal.mag() <= 0.) continue;
+
+      G4ThreeVector centre = (a + b + c) / 3.;
+      if (solid_->Inside(centre) != kInside) continue;
+
+      G4double distance = solid_->DistanceToOut(centre, normal.unit());
+      G4double size = std::max({(b - a).mag(), (c - b).mag(), (a - c).mag()});
+      if (distance <= size) sagitta = std::max(sagitta, distance);
+    }
+    return sagitta;
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::ProjectOnSurface
+  (const G4ThreeVector& p, const G4ThreeVector& normal) const
+  {
+    EInside inside = solid_->Inside(p);
+    if (inside == kSurface) return p;
+
+    // Points under a facet are moved out, and points over it (in concave
+    // surfaces) in, as long as the surface is close enough
+    G4double distance = (inside == kInside) ?
+      solid_->DistanceToOut(p, normal) : solid_->DistanceToIn(p, -normal);
+    if (distance >= kInfinity || distance > max_projection_) return p;
+
+    return (inside == kInside) ? p + distance * normal : p - distance * normal;
+  }
+
+
+
+  G4double SolidPointSampler::SignedVolume(const Triangle& t) const
+  {
+    return (t.a - apex_).dot((t.b - apex_).cross(t.c - apex_));
+  }
+
+
+
+  G4bool SolidPointSampler::InTetrahedron(const Triangle& t,
+                                          const G4ThreeVector& p) const
+  {
+    // The point must be on the same side of the four faces as the
+    // tetrahedron itself
+    G4double v = SignedVolume(t);
+    G4double v0 = (t.a - p).dot((t.b - p).cross(t.c - p));
+    G4double v1 = (p - apex_).dot((t.b - apex_).cross(t.c - apex_));
+    G4double v2 = (t.a - apex_).dot((p - apex_).cross(t.c - apex_));
+    G4double v3 = (t.a - apex_).dot((t.b - apex_).cross(p - apex_));
+
+    if (v < 0.) { v0 = -v0; v1 = -v1; v2 = -v2; v3 = -v3; }
+    return v0 >= 0. && v1 >= 0. && v2 >= 0. && v3 >= 0.;
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::RotateAndTranslate(G4ThreeVector position) const
+  {
+    G4ThreeVector real_pos = position;
+
+    // Rotating if needed
+    if (rotation_) real_pos *= *rotation_;
+    // Translating
+    real_pos += origin_;
+    return real_pos;
+  }
+
+} // end namespace nexus
@@ -0,0 +1,127 @@
+// ----------------------------------------------------------------------------
+// nexus | SolidPointSampler.h
+//
+// This class is a sampler of random uniform points in the volume or on the
+// surface of any Geant4 solid, including boolean solids and multi-unions.
+// The solid is tessellated once (via G4VSolid::GetPolyhedron) into
+// tetrahedra sharing a common apex and into surface triangles, and every
+// point is drawn from one of them chosen with an alias table. Since the
+// tessellation of curved surfaces is inscribed in them, the tetrahedra are
+// enlarged to enclose the solid (the points outside it being rejected) and
+// the surface points are projected onto the actual surface.
+//
+// Limitations:
+// - Surface points are uniform on the facets, not on the curved surface:
+//   their projection stretches them by up to the ratio between the areas
+//   of the surface and of the facet (1 + O(sagitta / radius)), which
+//   depends on the number of rotation steps of the polyhedra.
+// - Volume points of solids not star-shaped from the centre of their
+//   bounding box (e.g. hollow or boolean solids) are checked against
+//   every tetrahedron that may overlap theirs, so a draw costs O(k),
+//   k being the number of such tetrahedra, instead of O(1).
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SOLID_POINT_SAMPLER_H
+#define SOLID_POINT_SAMPLER_H
+
+#include "AliasTable.h"
+
+#include <G4ThreeVector.hh>
+#include <G4RotationMatrix.hh>
+
+#include <vector>
+
+class G4VSolid;
+class G4LogicalVolume;
+
+
+namespace nexus {
+
+  /// Sampler of random uniform points in (or on) any solid
+
+  class SolidPointSampler
+  {
+  public:
+    /// Constructor providing the solid and its placement
+    SolidPointSampler(const G4VSolid* solid,
+                      G4ThreeVector origin=G4ThreeVector(0.,0.,0.),
+                      G4RotationMatrix* rotation=nullptr);
+
+    /// Constructor providing the logical volume of the solid
+    SolidPointSampler(const G4LogicalVolume* logic,
+                      G4ThreeVector origin=G4ThreeVector(0.,0.,0.),
+                      G4RotationMatrix* rotation=nullptr);
+
+    /// Destructor
+    ~SolidPointSampler();
+
+    /// Return vertex within region <region> ("VOLUME" or "SURFACE")
+    G4ThreeVector GenerateVertex(const G4String& region) const;
+
+    /// Return the volume of the tessellated solid (before enlarging it)
+    G4double GetVolume() const;
+    /// Return the surface of the tessellated solid
+    G4double GetSurface() const;
+
+  private:
+    /// Triangle of the tessellation (a tetrahedron with the apex)
+    struct Triangle {
+      G4ThreeVector a, b, c;
+    };
+
+    void Build();
+
+    /// Return the largest distance between the facets and the surface
+    /// of the solid they approximate (zero for flat surfaces)
+    G4double GetMaxSagitta(const std::vector<G4ThreeVector>& vertices,
+                           const std::vector<std::vector<G4int>>& facets) const;
+
+    G4ThreeVector SampleVolume() const;
+    G4ThreeVector SampleSurface() const;
+
+    /// Return the signed volume of the tetrahedron apex-t (times 6)
+    G4double SignedVolume(const Triangle& t) const;
+    /// Return true if the point is in the tetrahedron apex-t
+    G4bool InTetrahedron(const Triangle& t, const G4ThreeVector& p) const;
+
+    /// Return the point of the surface of the solid closest to a point
+    /// of a facet with the given normal, along that normal
+    G4ThreeVector ProjectOnSurface(const G4ThreeVector& p,
+                                   const G4ThreeVector& normal) const;
+
+    G4ThreeVector RotateAndTranslate(G4ThreeVector position) const;
+
+  private:
+    const G4VSolid* solid_;
+
+    G4ThreeVector apex_;              ///< Common apex of the tetrahedra
+    std::vector<Triangle> triangles_; ///< Facets of the enlarged tessellation
+    std::vector<Triangle> facets_;    ///< Facets of the tessellation
+    std::vector<G4ThreeVector> normals_; ///< Outward normal of every facet
+    std::vector<G4int> sign_;         ///< Orientation of every tetrahedron
+    /// Tetrahedra that may overlap with every tetrahedron
+    std::vector<std::vector<size_t>> overlaps_;
+
+    AliasTable tetrahedra_table_; ///< Volume of every tetrahedron (if > 0)
+    AliasTable facets_table_;     ///< Area of every facet
+    G4double volume_;
+    G4double max_projection_; ///< Largest move of the surface points
+    static const G4int max_attempts_ = 100; ///< Draws of every surface point
+
+    G4ThreeVector origin_;
+    G4RotationMatrix* rotation_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4double SolidPointSampler::GetVolume() const
+  { return volume_; }
+
+  inline G4double SolidPointSampler::GetSurface() const
+  { return facets_table_.GetTotalWeight(); }
+
+} // namespace nexus
+
+#endif
@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// nexus | SpectrumSampler.cc
+//
+// This class samples photon energies from an emission spectrum given as a
+// tabulated (non-normalized) density. The distribution is the same as the
+// one obtained inverting the linear interpolation of its cumulative
+// integral, but every energy is sampled in constant time.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SpectrumSampler.h"
+
+#include <G4PhysicsVector.hh>
+#include <Randomize.hh>
+
+
+namespace nexus {
+
+
+  SpectrumSampler::SpectrumSampler(const G4PhysicsVector& spectrum)
+  {
+    const size_t n = spectrum.GetVectorLength();
+    if (n < 2) {
+      G4Exception("[SpectrumSampler]", "SpectrumSampler()", FatalException,
+                  "The spectrum needs at least two points.");
+    }
+
+    // Every bin is weighted with its area (trapezoidal rule),
+    // as in the cumulative integrals of the Geant4 processes
+    std::vector<G4double> areas(n-1);
+    for (size_t i=0; i<n; i++) energies_.push_back(spectrum.Energy(i));
+    for (size_t i=1; i<n; i++)
+      areas[i-1] = 0.5 * (spectrum.Energy(i) - spectrum.Energy(i-1))
+        * (spectrum[i] + spectrum[i-1]);
+
+    bins_.SetWeights(areas);
+  }
+
+
+
+  SpectrumSampler::~SpectrumSampler()
+  {
+  }
+
+
+
+  G4double SpectrumSampler::Shoot() const
+  {
+    G4double u1 = G4UniformRand();
+    G4double u2 = G4UniformRand();
+    return Sample(u1, u2);
+  }
+
+
+} // end namespace nexus
@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// nexus | SpectrumSampler.h
+//
+// This class samples photon energies from an emission spectrum given as a
+// tabulated (non-normalized) density. The distribution is the same as the
+// one obtained inverting the linear interpolation of its cumulative
+// integral, but every energy is sampled in constant time.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SPECTRUM_SAMPLER_H
+#define SPECTRUM_SAMPLER_H
+
+#include "AliasTable.h"
+
+#include <globals.hh>
+
+#include <vector>
+
+class G4PhysicsVector;
+
+
+namespace nexus {
+
+  class SpectrumSampler
+  {
+  public:
+    /// Constructor providing the tabulated spectrum
+    SpectrumSampler(const G4PhysicsVector& spectrum);
+    /// Destructor
+    ~SpectrumSampler();
+
+    /// Return an energy, given two uniform random numbers in [0, 1)
+    G4double Sample(G4double u1, G4double u2) const;
+
+    /// Return an energy, drawing the random numbers from the Geant4 engine
+    G4double Shoot() const;
+
+    /// Return the integral of the spectrum
+    G4double GetIntegral() const;
+
+  private:
+    std::vector<G4double> energies_; ///< Edges of the energy bins
+    AliasTable bins_;                ///< Probability of every bin
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4double SpectrumSampler::Sample(G4double u1, G4double u2) const
+  {
+    // The density is uniform within a bin
+    size_t i = bins_.Sample(u1);
+    return energies_[i] + u2 * (energies_[i+1] - energies_[i]);
+  }
+
+  inline G4double SpectrumSampler::GetIntegral() const
+  { return bins_.GetTotalWeight(); }
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,201 @@
+// ----------------------------------------------------------------------------
+// nexus | VoxelRegionSampler.cc
+//
+// This class samples random uniform points in a region made of one or more
+// volumes (identified by name) enclosed in a cylindrical shell. The first
+// time it is used, the shell is divided into voxels of equal volume, which
+// are classified with the navigator as inside the region, outside it or on
+// its boundary. Points are only drawn in the first and the last ones, and
+// only those of boundary voxels need to be checked, which avoids the low
+// acceptance of sampling the whole shell for thin or sparse regions.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VoxelRegionSampler.h"
+
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace nexus {
+
+  namespace {
+    // Points probed per voxel and dimension to find the region
+    const G4int nprobes = 3;
+
+    // Classification of the voxels
+    enum { OUTSIDE, INSIDE, BOUNDARY };
+  }
+
+
+  VoxelRegionSampler::VoxelRegionSampler(G4double minRad, G4double maxRad,
+                                         G4double halfLength,
+                                         const G4ThreeVector& origin,
+                                         const G4ThreeVector& global_offset,
+                                         const std::vector<G4String>& volumes,
+                                         G4int nvoxels):
+    min_rad2_(minRad*minRad), max_rad2_(maxRad*maxRad),
+    half_length_(halfLength), origin_(origin), global_offset_(global_offset),
+    volumes_(volumes), ninside_(0)
+  {
+    // Voxels of (roughly) the same size along every dimension
+    G4double volume = pi * (max_rad2_ - min_rad2_) * 2. * half_length_;
+    G4double size = std::cbrt(volume / nvoxels);
+
+    nr_   = std::max(1, (G4int) std::lround((maxRad - minRad) / size));
+    nphi_ = std::max(1, (G4int) std::lround(pi * (minRad + maxRad) / size));
+    nz_   = std::max(1, (G4int) std::lround(2. * half_length_ / size));
+  }
+
+
+
+  VoxelRegionSampler::~VoxelRegionSampler()
+  {
+  }
+
+
+
+  G4ThreeVector VoxelRegionSampler::GetPoint(G4int voxel, G4double ur,
+                                             G4double uphi, G4double uz) const
+  {
+    G4int iz   = voxel % nz_;
+    G4int iphi = (voxel / nz_) % nphi_;
+    G4int ir   = voxel / (nz_ * nphi_);
+
+    // The bins are uniform in r^2, so that all voxels have the same volume
+    G4double r2  = min_rad2_ + (ir + ur) * (max_rad2_ - min_rad2_) / nr_;
+    G4double phi = (iphi + uphi) * twopi / nphi_;
+    G4double z   = -half_length_ + (iz + uz) * 2. * half_length_ / nz_;
+
+    G4double r = std::sqrt(r2);
+    return origin_ + G4ThreeVector(r * std::cos(phi), r * std::sin(phi), z);
+  }
+
+
+
+  G4bool VoxelRegionSampler::IsRegionVolume(const G4VPhysicalVolume* volume) const
+  {
+    if (!volume) return false;
+    return std::find(volumes_.begin(), volumes_.end(), volume->GetName())
+      != volumes_.end();
+  }
+
+
+
+  G4bool VoxelRegionSampler::InRegion(const G4ThreeVector& point,
+                                      G4Navigator* navigator) const
+  {
+    G4VPhysicalVolume* volume =
+      navigator->LocateGlobalPointAndSetup(point + global_offset_, 0, false);
+
+    // Volumes are compared by name only if they were not seen while building
+    auto it = known_volumes_.find(volume);
+    if (it != known_volumes_.end()) return it->second;
+    return IsRegionVolume(volume);
+  }
+
+
+
+  G4int VoxelRegionSampler::Classify(G4int voxel, G4Navigator* navigator)
+  {
+    G4int ir = voxel / (nz_ * nphi_);
+
+    // Size of the cells of the probes along phi and z
+    G4double dphi = twopi / nphi_ / nprobes;
+    G4double dz = 2. * half_length_ / nz_ / nprobes;
+    // (along r they are not equally wide, since the bins are uniform in r^2)
+    G4double r2_step = (max_rad2_ - min_rad2_) / nr_ / nprobes;
+
+    G4bool in = false, out = false, boundary = false;
+
+    for (G4int i=0; i<nprobes; ++i) {
+      G4double rlow = std::sqrt(min_rad2_ + (ir * nprobes + i) * r2_step);
+      G4double rup  = std::sqrt(min_rad2_ + (ir * nprobes + i + 1) * r2_step);
+
+      // Every point of the cell is closer to its probe than this
+      // (generously, the whole diagonal, to cover the curvature)
+      G4double reach = std::sqrt((rup - rlow) * (rup - rlow) +
+                                 (rup * dphi) * (rup * dphi) + dz * dz);
+
+      for (G4int j=0; j<nprobes; ++j) {
+        for (G4int k=0; k<nprobes; ++k) {
+          G4ThreeVector point = GetPoint(voxel, (i+0.5)/nprobes,
+                                         (j+0.5)/nprobes, (k+0.5)/nprobes)
+            + global_offset_;
+          G4VPhysicalVolume* volume =
+            navigator->LocateGlobalPointAndSetup(point, 0, false);
+          auto known = known_volumes_.emplace(volume, false);
+          if (known.second) known.first->second = IsRegionVolume(volume);
+
+          if (known.first->second) in = true;
+          else out = true;
+
+          // A boundary of the volume (of either kind) is within the cell.
+          // (Out of the world there is no safety to compute.)
+          if (!volume || navigator->ComputeSafety(point, reach, false) < reach)
+            boundary = true;
+        }
+      }
+    }
+
+    if ((in && out) || boundary) return BOUNDARY;
+    return in ? INSIDE : OUTSIDE;
+  }
+
+
+
+  void VoxelRegionSampler::Build()
+  {
+    G4Navigator* navigator = G4TransportationManager::
+      GetTransportationManager()->GetNavigatorForTracking();
+
+    // A voxel is only discarded if it is known not to contain any of the
+    // region, so parts of it thinner than the probe spacing are not missed
+    const G4int nvoxels = nr_ * nphi_ * nz_;
+    std::vector<G4int> boundary;
+    for (G4int v=0; v<nvoxels; ++v) {
+      G4int type = Classify(v, navigator);
+      if (type == INSIDE) candidates_.push_back(v);
+      else if (type == BOUNDARY) boundary.push_back(v);
+    }
+
+    ninside_ = candidates_.size();
+    candidates_.insert(candidates_.end(), boundary.begin(), boundary.end());
+
+    if (candidates_.empty()) {
+      G4Exception("[VoxelRegionSampler]", "Build()", FatalException,
+                  "The region was not found in the enclosing volume.");
+    }
+  }
+
+
+
+  G4ThreeVector VoxelRegionSampler::GenerateVertex()
+  {
+    std::call_once(built_, &VoxelRegionSampler::Build, this);
+
+    G4Navigator* navigator = G4TransportationManager::
+      GetTransportationManager()->GetNavigatorForTracking();
+
+    // All voxels have the same volume, so they are chosen with equal
+    // probability. The points of the voxels fully inside the region are
+    // taken right away, whereas those of the boundary ones are checked,
+    // so that the distribution is exact.
+    while (true) {
+      G4double u = G4UniformRand();
+      size_t i = std::min(candidates_.size() - 1,
+                          (size_t) (u * candidates_.size()));
+      G4ThreeVector point = GetPoint(candidates_[i], G4UniformRand(),
+                                     G4UniformRand(), G4UniformRand());
+      if (i < ninside_ || InRegion(point, navigator)) return point;
+    }
+  }
+
+} // namespace nexus
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// nexus | VoxelRegionSampler.h
+//
+// This class samples random uniform points in a region made of one or more
+// volumes (identified by name) enclosed in a cylindrical shell. The first
+// time it is used, the shell is divided into voxels of equal volume, which
+// are classified with the navigator as inside the region, outside it or on
+// its boundary. Points are only drawn in the first and the last ones, and
+// only those of boundary voxels need to be checked, which avoids the low
+// acceptance of sampling the whole shell for thin or sparse regions.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VOXEL_REGION_SAMPLER_H
+#define VOXEL_REGION_SAMPLER_H
+
+#include <G4ThreeVector.hh>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class G4Navigator;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class VoxelRegionSampler
+  {
+  public:
+    /// Constructor providing the enclosing cylindrical shell (as in
+    /// CylinderPointSampler2020, with no rotation), the offset from local
+    /// to global coordinates, the names of the volumes of the region and
+    /// the approximate number of voxels
+    VoxelRegionSampler(G4double minRad, G4double maxRad, G4double halfLength,
+                       const G4ThreeVector& origin,
+                       const G4ThreeVector& global_offset,
+                       const std::vector<G4String>& volumes,
+                       G4int nvoxels = 20000);
+
+    /// Destructor
+    ~VoxelRegionSampler();
+
+    /// Return a random point of the region, in local coordinates.
+    /// The voxels are built in the first call (in any thread).
+    G4ThreeVector GenerateVertex();
+
+  private:
+    /// Classify the voxels, locating the region with the navigator
+    void Build();
+
+    /// Return the classification of a voxel, probing it on a regular grid
+    /// of points. It is only known to be inside (or outside) the region
+    /// if the safety distance of every probe covers the whole of its cell.
+    G4int Classify(G4int voxel, G4Navigator*);
+
+    /// Return the local position of a point of a voxel given its
+    /// fractional coordinates within it (uniform in volume)
+    G4ThreeVector GetPoint(G4int voxel, G4double ur, G4double uphi,
+                           G4double uz) const;
+
+    /// Return whether a local position belongs to the region
+    G4bool InRegion(const G4ThreeVector&, G4Navigator*) const;
+
+    /// Return whether a volume is one of the region, comparing names
+    G4bool IsRegionVolume(const G4VPhysicalVolume*) const;
+
+  private:
+    G4double min_rad2_, max_rad2_, half_length_;
+    G4ThreeVector origin_;
+    G4ThreeVector global_offset_;
+    std::vector<G4String> volumes_;
+
+    G4int nr_, nphi_, nz_; ///< Voxels along r^2, phi and z
+
+    std::once_flag built_;
+    /// Voxels containing part of the region (inside ones first)
+    std::vector<G4int> candidates_;
+    size_t ninside_; ///< Number of voxels fully inside the region
+
+    /// Volumes found while building, and whether they belong to the region
+    std::unordered_map<const G4VPhysicalVolume*, G4bool> known_volumes_;
+  };
+
+} // namespace nexus
+
+#endif
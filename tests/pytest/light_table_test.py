@@ -0,0 +1,105 @@
+import pytest
+
+import os
+import subprocess
+import tables as tb
+
+
+"""
+This module runs the light-table mode with and without streaming the
+photons of every event, and checks that the table is normalized to all
+the photons generated, not only to those that are primary particles.
+"""
+
+nphotons   = 20000
+nevents    = 4
+chunk_size = 2000
+
+
+def run_light_table_job(config_tmpdir, output_tmpdir, NEXUSDIR, base_name, chunk):
+    init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4RadioactiveDecayPhysics
+/PhysicsList/RegisterPhysics G4OpticalPhysics
+/PhysicsList/RegisterPhysics NexusPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+
+/nexus/RegisterGeometry Next100OpticalGeometry
+
+/nexus/RegisterGenerator ScintillationGenerator
+
+/nexus/RegisterPersistencyManager PersistencyManager
+
+/nexus/RegisterTrackingAction LightTableTrackingAction
+/nexus/RegisterEventAction SaveAllEventAction
+/nexus/RegisterRunAction DefaultRunAction
+/nexus/RegisterStackingAction DefaultStackingAction
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+    init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+    with open(init_path, 'w') as init_file:
+        init_file.write(init_text)
+
+    config_text = f"""
+/run/verbose 0
+/event/verbose 0
+/tracking/verbose 0
+
+/process/em/verbose 0
+
+/Geometry/Next100/pressure 15. bar
+/Geometry/Next100/max_step_size 1. mm
+
+/Generator/ScintGenerator/nphotons {nphotons}
+/Generator/ScintGenerator/chunk_size {chunk}
+/Generator/ScintGenerator/grid_min  0. 0. 0. mm
+/Generator/ScintGenerator/grid_max  0. 0. 0. mm
+/Generator/ScintGenerator/grid_step 1. 0. 0. mm
+/Generator/ScintGenerator/events_per_point {nevents}
+
+/nexus/persistency/light_table true
+/nexus/persistency/outputFile {output_tmpdir}/{base_name}
+/nexus/random_seed 21051817
+"""
+    config_path = os.path.join(config_tmpdir, base_name+'.config.mac')
+    with open(config_path, 'w') as config_file:
+        config_file.write(config_text)
+
+    nexus_exe = NEXUSDIR + '/bin/nexus'
+    command   = [nexus_exe, '-b', '-n', str(nevents), init_path]
+    subprocess.run(command, check=True, env=os.environ)
+
+    return os.path.join(output_tmpdir, base_name + '.h5')
+
+
+def read_light_table(filename):
+    with tb.open_file(filename) as h5in:
+        points = h5in.root.LightTable.points.read()
+        probs  = h5in.root.LightTable.probabilities.read()
+    return points, probs
+
+
+def test_light_table_with_streaming(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that streaming the photons does not change the light table."""
+
+    primaries = run_light_table_job(config_tmpdir, output_tmpdir, NEXUSDIR,
+                                    'NEXT100_light_table_primaries', 0)
+    streamed  = run_light_table_job(config_tmpdir, output_tmpdir, NEXUSDIR,
+                                    'NEXT100_light_table_streamed', chunk_size)
+
+    points_p, probs_p = read_light_table(primaries)
+    points_s, probs_s = read_light_table(streamed)
+
+    # All the photons generated count, whether they are primary or not
+    assert len(points_p) == len(points_s) == 1
+    assert points_p['nevents'][0]  == points_s['nevents'][0]  == nevents
+    assert points_p['nphotons'][0] == points_s['nphotons'][0] == nevents * nphotons
+
+    # The total probability of detection agrees within its fluctuations
+    total_p = probs_p['probability'].sum()
+    total_s = probs_s['probability'].sum()
+    assert total_p > 0
+    sigma = (total_p / (nevents * nphotons))**0.5
+    assert abs(total_s - total_p) < 5 * 2**0.5 * sigma